@@ -32,6 +32,8 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <fstream>
+#include <sstream>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
@@ -98,12 +100,20 @@ void SetPadMultiLineMessages(bool value)
   tDomainRegistry::Instance().SetPadMultiLineMessages(value);
 }
 
+//----------------------------------------------------------------------
+// SetClassicFormatting
+//----------------------------------------------------------------------
+void SetClassicFormatting(bool value)
+{
+  tDomainRegistry::Instance().SetClassicFormatting(value);
+}
+
 //----------------------------------------------------------------------
 // SetDomainPrintsName
 //----------------------------------------------------------------------
 void SetDomainPrintsName(const std::string &domain_name, bool value, const tDefaultConfigurationContext &default_context)
 {
-  const_cast<tConfiguration &>(tDomainRegistry::Instance().GetConfiguration(default_context, NULL, domain_name.c_str())).SetPrintsName(value);
+  const_cast<tConfiguration &>(tDomainRegistry::Instance().GetConfigurationBySourceRelativeFilename(default_context, NULL, domain_name.c_str())).SetPrintsName(value);
 }
 
 //----------------------------------------------------------------------
@@ -111,7 +121,7 @@ void SetDomainPrintsName(const std::string &domain_name, bool value, const tDefa
 //----------------------------------------------------------------------
 void SetDomainPrintsTime(const std::string &domain_name, bool value, const tDefaultConfigurationContext &default_context)
 {
-  const_cast<tConfiguration &>(tDomainRegistry::Instance().GetConfiguration(default_context, NULL, domain_name.c_str())).SetPrintsTime(value);
+  const_cast<tConfiguration &>(tDomainRegistry::Instance().GetConfigurationBySourceRelativeFilename(default_context, NULL, domain_name.c_str())).SetPrintsTime(value);
 }
 
 //----------------------------------------------------------------------
@@ -119,7 +129,7 @@ void SetDomainPrintsTime(const std::string &domain_name, bool value, const tDefa
 //----------------------------------------------------------------------
 void SetDomainPrintsLevel(const std::string &domain_name, bool value, const tDefaultConfigurationContext &default_context)
 {
-  const_cast<tConfiguration &>(tDomainRegistry::Instance().GetConfiguration(default_context, NULL, domain_name.c_str())).SetPrintsLevel(value);
+  const_cast<tConfiguration &>(tDomainRegistry::Instance().GetConfigurationBySourceRelativeFilename(default_context, NULL, domain_name.c_str())).SetPrintsLevel(value);
 }
 
 //----------------------------------------------------------------------
@@ -127,7 +137,7 @@ void SetDomainPrintsLevel(const std::string &domain_name, bool value, const tDef
 //----------------------------------------------------------------------
 void SetDomainPrintsLocation(const std::string &domain_name, bool value, const tDefaultConfigurationContext &default_context)
 {
-  const_cast<tConfiguration &>(tDomainRegistry::Instance().GetConfiguration(default_context, NULL, domain_name.c_str())).SetPrintsLocation(value);
+  const_cast<tConfiguration &>(tDomainRegistry::Instance().GetConfigurationBySourceRelativeFilename(default_context, NULL, domain_name.c_str())).SetPrintsLocation(value);
 }
 
 //----------------------------------------------------------------------
@@ -135,7 +145,15 @@ void SetDomainPrintsLocation(const std::string &domain_name, bool value, const t
 //----------------------------------------------------------------------
 void SetDomainMaxMessageLevel(const std::string &domain_name, tLogLevel level, const tDefaultConfigurationContext &default_context)
 {
-  const_cast<tConfiguration &>(tDomainRegistry::Instance().GetConfiguration(default_context, NULL, domain_name.c_str())).SetMaxMessageLevel(level);
+  const_cast<tConfiguration &>(tDomainRegistry::Instance().GetConfigurationBySourceRelativeFilename(default_context, NULL, domain_name.c_str())).SetMaxMessageLevel(level);
+}
+
+//----------------------------------------------------------------------
+// SetDomainPrefixTemplate
+//----------------------------------------------------------------------
+void SetDomainPrefixTemplate(const std::string &domain_name, const std::string &prefix_template, const tDefaultConfigurationContext &default_context)
+{
+  const_cast<tConfiguration &>(tDomainRegistry::Instance().GetConfigurationBySourceRelativeFilename(default_context, NULL, domain_name.c_str())).SetPrefixTemplate(prefix_template);
 }
 
 //----------------------------------------------------------------------
@@ -148,7 +166,8 @@ void PrintDomainConfigurations()
     static void Print(const tConfiguration &configuration)
     {
       std::cout << configuration.GetFullQualifiedName() << " (" << &configuration << ")" << std::endl;
-      for (auto it = configuration.Children().begin(); it != configuration.Children().end(); ++it)
+      const std::vector<tConfiguration *> children(configuration.Children());
+      for (auto it = children.begin(); it != children.end(); ++it)
       {
         Print(**it);
       }
@@ -158,6 +177,54 @@ void PrintDomainConfigurations()
   RecursionHandler::Print(tDomainRegistry::Instance().GetConfiguration(cDEFAULT_CONTEXT, NULL, "."));
 }
 
+//----------------------------------------------------------------------
+// FreezeDomainRegistry
+//----------------------------------------------------------------------
+void FreezeDomainRegistry()
+{
+  tDomainRegistry::Instance().Freeze();
+}
+
+//----------------------------------------------------------------------
+// LoadDomainManifest
+//----------------------------------------------------------------------
+bool LoadDomainManifest(const std::string &filename)
+{
+  std::ifstream manifest(filename.c_str());
+  if (!manifest.is_open())
+  {
+    RRLIB_LOG_PRINT(ERROR, "Could not open domain manifest '", filename, "'");
+    return false;
+  }
+
+  tDomainRegistryImplementation &registry = tDomainRegistry::Instance();
+  std::string line;
+  while (std::getline(manifest, line))
+  {
+    std::istringstream entries(line);
+    std::string entry;
+    if (!(entries >> entry) || entry[0] == '#')
+    {
+      continue;
+    }
+
+    if (entry[0] == '.')
+    {
+      registry.GetConfigurationBySourceRelativeFilename(cDEFAULT_CONTEXT, NULL, entry.c_str());
+      continue;
+    }
+
+    const std::string source_filename(entry);
+    registry.GetConfigurationBySourceRelativeFilename(cDEFAULT_CONTEXT, source_filename.c_str());
+    while (entries >> entry)
+    {
+      registry.GetConfigurationBySourceRelativeFilename(cDEFAULT_CONTEXT, source_filename.c_str(), entry.c_str());
+    }
+  }
+
+  return true;
+}
+
 //----------------------------------------------------------------------
 // ConfigureFromFile
 //----------------------------------------------------------------------
@@ -207,7 +274,7 @@ bool AddConfigurationFromXMLNode(const xml::tNode &node, const std::string &pare
   }
   name += node_name;
 
-  tConfiguration &configuration = const_cast<tConfiguration &>(GetConfiguration(NULL, name.c_str()));
+  tConfiguration &configuration = const_cast<tConfiguration &>(tDomainRegistry::Instance().GetConfigurationBySourceRelativeFilename(cDEFAULT_CONTEXT, NULL, name.c_str()));
 
   if (node.HasAttribute("prints_name"))
   {
@@ -234,6 +301,11 @@ bool AddConfigurationFromXMLNode(const xml::tNode &node, const std::string &pare
     configuration.SetMaxMessageLevel(node.GetEnumAttribute<tLogLevel>("max_level"));
   }
 
+  if (node.HasAttribute("prefix"))
+  {
+    configuration.SetPrefixTemplate(node.GetStringAttribute("prefix"));
+  }
+
   for (xml::tNode::const_iterator it = node.ChildrenBegin(); it != node.ChildrenEnd(); ++it)
   {
     if (it->Name() == "sink")
@@ -283,6 +355,10 @@ bool ConfigureFromXMLNode(const xml::tNode &node)
     {
       SetPadMultiLineMessages(node.GetBoolAttribute("pad_multi_line_messages"));
     }
+    if (node.HasAttribute("classic_formatting"))
+    {
+      SetClassicFormatting(node.GetBoolAttribute("classic_formatting"));
+    }
 
     for (xml::tNode::const_iterator it = node.ChildrenBegin(); it != node.ChildrenEnd(); ++it)
     {
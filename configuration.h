@@ -70,6 +70,17 @@ void SetPadPrefixColumns(bool value);
 
 void SetPadMultiLineMessages(bool value);
 
+/*! Format messages independent of the global locale
+ *
+ * If enabled, numbers are always formatted like in the classic "C"
+ * locale, without consulting any locale facets. The default is
+ * disabled unless the library was built with
+ * RRLIB_LOGGING_CLASSIC_FORMATTING.
+ *
+ * \param value   Whether messages should be formatted using the classic locale
+ */
+void SetClassicFormatting(bool value);
+
 void SetDomainPrintsName(const std::string &domain_name, bool value, const tDefaultConfigurationContext &default_context = cDEFAULT_CONTEXT);
 
 void SetDomainPrintsTime(const std::string &domain_name, bool value, const tDefaultConfigurationContext &default_context = cDEFAULT_CONTEXT);
@@ -80,8 +91,52 @@ void SetDomainPrintsLocation(const std::string &domain_name, bool value, const t
 
 void SetDomainMaxMessageLevel(const std::string &domain_name, tLogLevel level, const tDefaultConfigurationContext &default_context = cDEFAULT_CONTEXT);
 
+/*! Set the template for the prefix of messages in a domain and its subdomains
+ *
+ * The template consists of literal text and the fields %T (time), %N
+ * (domain name), %L (level), %D (log description), %F (function), %f
+ * (file), %l (line) and %% (literal %). E.g. "%T %L %D::%F >> ".
+ * It is compiled once and overrides the prints_* settings unless it is
+ * an empty string. With RRLIB_LOGGING_LESS_OUTPUT templates are ignored.
+ *
+ * \param domain_name       The name of the domain
+ * \param prefix_template   The template or an empty string to use the prints_* settings
+ * \param default_context   The default configuration context used to create the domain
+ */
+void SetDomainPrefixTemplate(const std::string &domain_name, const std::string &prefix_template, const tDefaultConfigurationContext &default_context = cDEFAULT_CONTEXT);
+
 void PrintDomainConfigurations();
 
+/*! Freeze the current set of logging domains for faster lookup
+ *
+ * Most processes create all of their logging domains during startup.
+ * Calling this method afterwards compiles the domain tree into a flat
+ * table with perfect hashing, which is used for all following lookups
+ * of known domains. Domains that are created later are still found
+ * and can be included by calling this method again.
+ */
+void FreezeDomainRegistry();
+
+/*! Create logging domains listed in a manifest file ahead of time
+ *
+ * Logging domains are created on the first message sent to them, which
+ * allocates memory and takes locks in the calling thread. To avoid that
+ * on time critical paths, a manifest of all domains (e.g. generated by
+ * the build system) can be loaded at startup to create the whole domain
+ * tree in advance. That also keeps padded prefix columns stable from the
+ * first message.
+ *
+ * Each line of the manifest contains either an absolute domain name
+ * (starting with '.') or a source file relative to RRLIB_LOGGING_PATH,
+ * optionally followed by the domain names used in that file.
+ * Empty lines and lines starting with '#' are ignored.
+ *
+ * \param filename   The manifest file to be read
+ *
+ * \returns Whether the manifest could be read or not
+ */
+bool LoadDomainManifest(const std::string &filename);
+
 /*! Read domain configuration from a given XML file
  *
  * The overall configuration of the logging domains tends to be
@@ -36,11 +36,13 @@
 #include <cstring>
 #include <sstream>
 #include <iostream>
+#include <algorithm>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
 #include "rrlib/logging/configuration/tDomainRegistry.h"
+#include "rrlib/logging/messages/tStream.h"
 #include "rrlib/logging/sinks/tFile.h"
 
 //----------------------------------------------------------------------
@@ -66,26 +68,78 @@ namespace logging
 //----------------------------------------------------------------------
 // Const values
 //----------------------------------------------------------------------
+const size_t cINITIAL_CHILDREN_INDEX_SIZE = 8;
 
 //----------------------------------------------------------------------
 // Implementation
 //----------------------------------------------------------------------
 
+namespace
+{
+size_t HashName(const char *name, size_t length)
+{
+  // FNV-1a
+  size_t hash = 2166136261u;
+  for (size_t i = 0; i < length; ++i)
+  {
+    hash = (hash ^ static_cast<unsigned char>(name[i])) * 16777619u;
+  }
+  return hash;
+}
+}
+
+std::atomic<unsigned int> tConfiguration::structure_epoch(1);
+std::atomic<unsigned int> tConfiguration::last_change(0);
+
 //----------------------------------------------------------------------
 // tConfiguration constructors
 //----------------------------------------------------------------------
 tConfiguration::tConfiguration(const tDefaultConfigurationContext &default_context, const tConfiguration *parent, const std::string &name)
   : parent(parent),
     name(name),
-    prints_name(parent ? parent->prints_name : default_context.cPRINTS_NAME),
-    prints_time(parent ? parent->prints_time : default_context.cPRINTS_TIME),
-    prints_level(parent ? parent->prints_level : default_context.cPRINTS_LEVEL),
-    prints_location(parent ? parent->prints_location : default_context.cPRINTS_LOCATION),
-    max_message_level(parent ? parent->max_message_level : default_context.cMAX_LOG_LEVEL),
-    sinks(parent ? parent->sinks : default_context.cSINKS),
-    stream_buffer_ready(false)
+    full_qualified_name((parent && parent->parent ? parent->GetFullQualifiedName() : "") + "." + name),
+    padded_full_qualified_name(NULL),
+    settings_generation(1),
+    sinks_generation(1),
+    effective_settings(0),
+    added_sinks(std::make_shared<const tAddedSinks>()),
+    sinks_cleared(0),
+    prefix_template_override(NULL),
+    prefix_template_generation(0),
+    prefix_template(NULL),
+    stream_buffer_generation(0),
+    name_hash(HashName(name.c_str(), name.length())),
+    children_index(NULL)
 {
   assert(name.length() || !parent);
+
+  // Descendants inherit everything. The root gets the defaults as overrides with the oldest possible timestamp
+  const bool is_root = !parent;
+  this->overrides[static_cast<size_t>(tSetting::PRINTS_NAME)].store(is_root && default_context.cPRINTS_NAME, std::memory_order_relaxed);
+  this->overrides[static_cast<size_t>(tSetting::PRINTS_TIME)].store(is_root && default_context.cPRINTS_TIME, std::memory_order_relaxed);
+  this->overrides[static_cast<size_t>(tSetting::PRINTS_LEVEL)].store(is_root && default_context.cPRINTS_LEVEL, std::memory_order_relaxed);
+  this->overrides[static_cast<size_t>(tSetting::PRINTS_LOCATION)].store(is_root && default_context.cPRINTS_LOCATION, std::memory_order_relaxed);
+  this->overrides[static_cast<size_t>(tSetting::MAX_MESSAGE_LEVEL)].store(is_root ? static_cast<uint64_t>(default_context.cMAX_LOG_LEVEL) : 0, std::memory_order_relaxed);
+  if (is_root)
+  {
+    std::shared_ptr<tAddedSinks> added_sinks(new tAddedSinks());
+    for (auto it = default_context.cSINKS.begin(); it != default_context.cSINKS.end(); ++it)
+    {
+      added_sinks->push_back(std::make_pair(0, *it));
+    }
+    this->added_sinks = added_sinks;
+  }
+}
+
+tConfiguration::tChildrenIndex::tChildrenIndex(size_t size)
+  : mask(size - 1),
+    slots(new std::atomic<tConfiguration *>[size])
+{
+  assert((size & this->mask) == 0 && "size must be a power of two");
+  for (size_t i = 0; i < size; ++i)
+  {
+    this->slots[i].store(NULL, std::memory_order_relaxed);
+  }
 }
 
 //----------------------------------------------------------------------
@@ -104,11 +158,7 @@ tConfiguration::~tConfiguration()
 //----------------------------------------------------------------------
 void tConfiguration::SetPrintsName(bool value)
 {
-  this->prints_name = value;
-  for (auto it = this->children.begin(); it != this->children.end(); ++it)
-  {
-    (*it)->SetPrintsName(value);
-  }
+  this->SetOverride(tSetting::PRINTS_NAME, value);
 }
 
 //----------------------------------------------------------------------
@@ -116,11 +166,7 @@ void tConfiguration::SetPrintsName(bool value)
 //----------------------------------------------------------------------
 void tConfiguration::SetPrintsTime(bool value)
 {
-  this->prints_time = value;
-  for (auto it = this->children.begin(); it != this->children.end(); ++it)
-  {
-    (*it)->SetPrintsTime(value);
-  }
+  this->SetOverride(tSetting::PRINTS_TIME, value);
 }
 
 //----------------------------------------------------------------------
@@ -128,11 +174,7 @@ void tConfiguration::SetPrintsTime(bool value)
 //----------------------------------------------------------------------
 void tConfiguration::SetPrintsLevel(bool value)
 {
-  this->prints_level = value;
-  for (auto it = this->children.begin(); it != this->children.end(); ++it)
-  {
-    (*it)->SetPrintsLevel(value);
-  }
+  this->SetOverride(tSetting::PRINTS_LEVEL, value);
 }
 
 //----------------------------------------------------------------------
@@ -140,11 +182,7 @@ void tConfiguration::SetPrintsLevel(bool value)
 //----------------------------------------------------------------------
 void tConfiguration::SetPrintsLocation(bool value)
 {
-  this->prints_location = value;
-  for (auto it = this->children.begin(); it != this->children.end(); ++it)
-  {
-    (*it)->SetPrintsLocation(value);
-  }
+  this->SetOverride(tSetting::PRINTS_LOCATION, value);
 }
 
 //----------------------------------------------------------------------
@@ -152,11 +190,7 @@ void tConfiguration::SetPrintsLocation(bool value)
 //----------------------------------------------------------------------
 void tConfiguration::SetMaxMessageLevel(tLogLevel level)
 {
-  this->max_message_level = level;
-  for (auto it = this->children.begin(); it != this->children.end(); ++it)
-  {
-    (*it)->SetMaxMessageLevel(level);
-  }
+  this->SetOverride(tSetting::MAX_MESSAGE_LEVEL, static_cast<unsigned int>(level));
 }
 
 //----------------------------------------------------------------------
@@ -164,13 +198,14 @@ void tConfiguration::SetMaxMessageLevel(tLogLevel level)
 //----------------------------------------------------------------------
 void tConfiguration::ClearSinks()
 {
-  this->sinks.clear();
-  this->stream_buffer_ready = false;
-
-  for (auto it = this->children.begin(); it != this->children.end(); ++it)
   {
-    (*it)->ClearSinks();
+    std::lock_guard<std::mutex> lock(this->children_mutex);
+
+    // Sinks added to this domain before are hidden by the new timestamp anyway
+    this->sinks_cleared.store(++last_change, std::memory_order_relaxed);
+    std::atomic_store(&this->added_sinks, std::make_shared<const tAddedSinks>());
   }
+  this->InvalidateSubtree(&tConfiguration::sinks_generation);
 }
 
 //----------------------------------------------------------------------
@@ -178,13 +213,35 @@ void tConfiguration::ClearSinks()
 //----------------------------------------------------------------------
 void tConfiguration::AddSink(std::shared_ptr<sinks::tSink> sink)
 {
-  this->sinks.push_back(sink);
-  this->stream_buffer_ready = false;
+  {
+    // Copy on write: resolving threads might still use the former list
+    std::lock_guard<std::mutex> lock(this->children_mutex);
+    std::shared_ptr<tAddedSinks> added_sinks(new tAddedSinks(*std::atomic_load(&this->added_sinks)));
+    added_sinks->push_back(std::make_pair(++last_change, sink));
+    std::atomic_store(&this->added_sinks, std::shared_ptr<const tAddedSinks>(added_sinks));
+  }
+  this->InvalidateSubtree(&tConfiguration::sinks_generation);
+}
 
-  for (auto it = this->children.begin(); it != this->children.end(); ++it)
+//----------------------------------------------------------------------
+// tConfiguration SetPrefixTemplate
+//----------------------------------------------------------------------
+void tConfiguration::SetPrefixTemplate(const std::string &prefix_template)
+{
+  // Compile the template before taking the lock
+  std::unique_ptr<tPrefixTemplateOverride> prefix_template_override(new tPrefixTemplateOverride());
+  if (!prefix_template.empty())
   {
-    (*it)->AddSink(sink);
+    prefix_template_override->prefix_template.reset(new tPrefixTemplate(prefix_template));
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->children_mutex);
+    prefix_template_override->timestamp = ++last_change;
+    this->prefix_template_override.store(prefix_template_override.get(), std::memory_order_release);
+    this->prefix_template_overrides.push_back(std::move(prefix_template_override));
   }
+  this->InvalidateSubtree(&tConfiguration::settings_generation);
 }
 
 //----------------------------------------------------------------------
@@ -236,15 +293,8 @@ const tConfiguration &tConfiguration::GetChild(const tDefaultConfigurationContex
     if (!configuration)
     {
       configuration = new tConfiguration(default_context, this, std::string(name, length));
-      const tConfiguration *parent = configuration->parent;
-      size_t full_name_length = 0;
-      while (parent)
-      {
-        full_name_length += parent->Name().length() + 1;
-        parent = parent->parent;
-      }
-      tDomainRegistry::Instance().UpdateMaxDomainNameLength(full_name_length + configuration->Name().length());
-      this->children.insert(this->FindInsertionPoint(length), configuration);
+      tDomainRegistry::Instance().UpdateMaxDomainNameLength(configuration->GetFullQualifiedName().length());
+      this->InsertChild(configuration);
     }
   }
 
@@ -256,50 +306,195 @@ const tConfiguration &tConfiguration::GetChild(const tDefaultConfigurationContex
 //----------------------------------------------------------------------
 tConfiguration *tConfiguration::FindChild(const char *name, size_t length) const
 {
-  // Iterate over sorted list of children (must be sorted longest name first to work)
-  for (auto it = this->children.begin(); it != this->children.end(); ++it)
+  // Lock-free lookup: indices are only published completely filled and slots are only changed from empty to final
+  const tChildrenIndex *index = this->children_index.load(std::memory_order_acquire);
+  if (!index)
   {
-    const size_t current_length = (*it)->Name().length();
+    return NULL;
+  }
 
-    // Skip too long names
-    if (current_length > length)
+  // Linear probing in open addressed hash index (size is a power of two)
+  const size_t hash = HashName(name, length);
+  for (size_t i = hash & index->mask;; i = (i + 1) & index->mask)
+  {
+    tConfiguration *candidate = index->slots[i].load(std::memory_order_acquire);
+    if (!candidate)
+    {
+      return NULL;
+    }
+    if (candidate->name_hash == hash && candidate->Name().length() == length && std::memcmp(name, candidate->Name().c_str(), length) == 0)
     {
-      continue;
+      return candidate;
     }
+  }
+}
+
+//----------------------------------------------------------------------
+// tConfiguration InsertChild
+//----------------------------------------------------------------------
+void tConfiguration::InsertChild(tConfiguration *child) const
+{
+  // Must be called with children_mutex locked. Writers are serialized, readers are not blocked.
 
-    // Compare names of matching length
-    if (current_length == length)
+  // Keep list of children sorted longest name first for stable iteration order
+  auto insertion_point = this->children.begin();
+  while (insertion_point != this->children.end() && (*insertion_point)->Name().length() >= child->Name().length())
+  {
+    ++insertion_point;
+  }
+  this->children.insert(insertion_point, child);
+
+  tChildrenIndex *index = this->children_index.load(std::memory_order_relaxed);
+
+  // Publish a new index with double size if load factor would exceed 1/2
+  // Replaced indices are kept until destruction as concurrent readers might still use them
+  if (!index || 2 * this->children.size() > index->mask + 1)
+  {
+    index = new tChildrenIndex(index ? 2 * (index->mask + 1) : cINITIAL_CHILDREN_INDEX_SIZE);
+    this->children_indices.emplace_back(index);
+    for (auto it = this->children.begin(); it != this->children.end(); ++it)
     {
-      if (std::strncmp(name, (*it)->Name().c_str(), length) == 0)
+      size_t i = (*it)->name_hash & index->mask;
+      while (index->slots[i].load(std::memory_order_relaxed))
       {
-        return *it;
+        i = (i + 1) & index->mask;
       }
-      continue;
+      index->slots[i].store(*it, std::memory_order_relaxed);
     }
+    this->children_index.store(index, std::memory_order_release);
+    return;
+  }
 
-    // Shorter names start -> can not be found anymore
-    break;
+  size_t i = child->name_hash & index->mask;
+  while (index->slots[i].load(std::memory_order_relaxed))
+  {
+    i = (i + 1) & index->mask;
   }
-  return NULL;
+  index->slots[i].store(child, std::memory_order_release);
 }
 
 //----------------------------------------------------------------------
-// tConfiguration FindInsertionPoint
+// tConfiguration ResolveSettings
 //----------------------------------------------------------------------
-std::list<tConfiguration *>::iterator tConfiguration::FindInsertionPoint(size_t length) const
+unsigned int tConfiguration::ResolveSettings() const
 {
-  // Iterate over sorted list of children (must be sorted longest name first to work)
-  for (auto it = this->children.begin(); it != this->children.end(); ++it)
+  // Read the generation first. If settings change meanwhile, the result is resolved again next time
+  const unsigned int current_generation = this->settings_generation.load(std::memory_order_acquire);
+
+  uint64_t latest[static_cast<size_t>(tSetting::DIMENSION)] = { 0 };
+  for (const tConfiguration *configuration = this; configuration; configuration = configuration->parent)
+  {
+    for (size_t i = 0; i < static_cast<size_t>(tSetting::DIMENSION); ++i)
+    {
+      latest[i] = std::max(latest[i], configuration->overrides[i].load(std::memory_order_relaxed));
+    }
+  }
+
+  unsigned int settings = static_cast<unsigned int>(latest[static_cast<size_t>(tSetting::MAX_MESSAGE_LEVEL)] & 0xFF) << static_cast<int>(tSetting::MAX_MESSAGE_LEVEL);
+  for (size_t i = 0; i < static_cast<size_t>(tSetting::MAX_MESSAGE_LEVEL); ++i)
+  {
+    settings |= static_cast<unsigned int>(latest[i] & 0x1) << i;
+  }
+
+  this->effective_settings.store(static_cast<uint64_t>(current_generation) << 32 | settings, std::memory_order_relaxed);
+  return settings;
+}
+
+//----------------------------------------------------------------------
+// tConfiguration ResolveSinks
+//----------------------------------------------------------------------
+std::shared_ptr<const tConfiguration::tSinks> tConfiguration::ResolveSinks() const
+{
+  unsigned int sinks_cleared = 0;
+  for (const tConfiguration *configuration = this; configuration; configuration = configuration->parent)
   {
-    const size_t current_length = (*it)->Name().length();
+    sinks_cleared = std::max(sinks_cleared, configuration->sinks_cleared.load(std::memory_order_relaxed));
+  }
+
+  tAddedSinks added_sinks;
+  for (const tConfiguration *configuration = this; configuration; configuration = configuration->parent)
+  {
+    const std::shared_ptr<const tAddedSinks> configuration_sinks = std::atomic_load(&configuration->added_sinks);
+    for (auto it = configuration_sinks->begin(); it != configuration_sinks->end(); ++it)
+    {
+      if (it->first >= sinks_cleared)
+      {
+        added_sinks.push_back(*it);
+      }
+    }
+  }
+
+  // Restore the order in which the sinks were added
+  std::stable_sort(added_sinks.begin(), added_sinks.end(), [](const tAddedSinks::value_type & a, const tAddedSinks::value_type & b)
+  {
+    return a.first < b.first;
+  });
+
+  std::shared_ptr<tSinks> sinks(new tSinks());
+  for (auto it = added_sinks.begin(); it != added_sinks.end(); ++it)
+  {
+    sinks->push_back(it->second);
+  }
+  return sinks;
+}
+
+//----------------------------------------------------------------------
+// tConfiguration ResolvePrefixTemplate
+//----------------------------------------------------------------------
+const tPrefixTemplate *tConfiguration::ResolvePrefixTemplate() const
+{
+  // Serialize resolvers, so that the published template always belongs to the published generation
+  std::lock_guard<std::mutex> lock(this->children_mutex);
+
+  const unsigned int current_generation = this->settings_generation.load(std::memory_order_acquire);
+  if (this->prefix_template_generation.load(std::memory_order_relaxed) == current_generation)
+  {
+    return this->prefix_template.load(std::memory_order_relaxed);
+  }
 
-    // Shorter names start -> insert new configuration before
-    if (current_length < length)
+  const tPrefixTemplateOverride *latest = NULL;
+  for (const tConfiguration *configuration = this; configuration; configuration = configuration->parent)
+  {
+    const tPrefixTemplateOverride *prefix_template_override = configuration->prefix_template_override.load(std::memory_order_acquire);
+    if (prefix_template_override && (!latest || prefix_template_override->timestamp > latest->timestamp))
     {
-      return it;
+      latest = prefix_template_override;
     }
   }
-  return this->children.end();
+
+  const tPrefixTemplate *prefix_template = latest && latest->prefix_template ? latest->prefix_template.get() :
+      &tPrefixTemplate::Default(this->PrintsTime(), this->PrintsName(), this->PrintsLevel(), this->PrintsLocation());
+
+  this->prefix_template.store(prefix_template, std::memory_order_release);
+  this->prefix_template_generation.store(current_generation, std::memory_order_release);
+  return prefix_template;
+}
+
+//----------------------------------------------------------------------
+// tConfiguration SetOverride
+//----------------------------------------------------------------------
+void tConfiguration::SetOverride(tSetting setting, unsigned int value)
+{
+  // The timestamp orders this override against the ones of ancestors and descendants
+  const uint64_t timestamp = ++last_change;
+  this->overrides[static_cast<size_t>(setting)].store(timestamp << 8 | value, std::memory_order_relaxed);
+
+  // Invalidate cached effective settings once the override is visible
+  this->InvalidateSubtree(&tConfiguration::settings_generation);
+}
+
+//----------------------------------------------------------------------
+// tConfiguration InvalidateSubtree
+//----------------------------------------------------------------------
+void tConfiguration::InvalidateSubtree(std::atomic<unsigned int> tConfiguration::*subtree_generation)
+{
+  // Only this domain and its descendants inherit the change. Children added meanwhile resolve from scratch anyway
+  (this->*subtree_generation)++;
+  const std::vector<tConfiguration *> children = this->Children();
+  for (auto it = children.begin(); it != children.end(); ++it)
+  {
+    (*it)->InvalidateSubtree(subtree_generation);
+  }
 }
 
 //----------------------------------------------------------------------
@@ -307,13 +502,59 @@ std::list<tConfiguration *>::iterator tConfiguration::FindInsertionPoint(size_t
 //----------------------------------------------------------------------
 void tConfiguration::PrepareStreamBuffer() const
 {
-  this->stream_buffer.Clear();
-  for (auto sink = this->sinks.begin(); sink != this->sinks.end(); ++sink)
+  // Records are written to the sinks while holding this lock
+  std::lock_guard<std::mutex> lock(tStreamMutex::Instance());
+
+  // Read the generation before resolving the sinks. Changes from now on trigger another preparation
+  const unsigned int current_generation = this->sinks_generation.load(std::memory_order_acquire);
+  if (this->stream_buffer_generation.load(std::memory_order_relaxed) == current_generation)
+  {
+    return;
+  }
+
+  std::shared_ptr<const tSinks> sinks = this->ResolveSinks();
+  if (!this->stream_buffer_sinks || *sinks != *this->stream_buffer_sinks)
+  {
+    try
+    {
+      // Keep the sinks alive as long as the stream buffer uses them
+      this->stream_buffer_sinks = sinks;
+      this->stream_buffer.Clear();
+      for (auto sink = this->stream_buffer_sinks->begin(); sink != this->stream_buffer_sinks->end(); ++sink)
+      {
+        this->stream_buffer.AddSink((*sink)->GetStreamBuffer());
+      }
+    }
+    catch (...)
+    {
+      this->stream_buffer.Clear();
+      this->stream_buffer_sinks.reset();
+      throw;
+    }
+  }
+
+  this->stream_buffer_generation.store(current_generation, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------
+// tConfiguration PreparePaddedFullQualifiedName
+//----------------------------------------------------------------------
+const std::string *tConfiguration::PreparePaddedFullQualifiedName(size_t width) const
+{
+  std::lock_guard<std::mutex> lock(this->children_mutex);
+
+  const std::string *padded_name = this->padded_full_qualified_name.load(std::memory_order_relaxed);
+  if (padded_name && padded_name->length() >= width + 1)
   {
-    this->stream_buffer.AddSink((*sink)->GetStreamBuffer());
+    return padded_name;
   }
 
-  this->stream_buffer_ready = true;
+  // The width only grows with the longest domain name. Former renderings are kept as concurrent printers might still use them
+  std::string *new_padded_name = new std::string(this->full_qualified_name);
+  new_padded_name->resize(std::max(width, this->full_qualified_name.length()) + 1, ' ');
+  this->padded_full_qualified_names.emplace_back(new_padded_name);
+  this->padded_full_qualified_name.store(new_padded_name, std::memory_order_release);
+  return new_padded_name;
 }
 
 //----------------------------------------------------------------------
@@ -64,15 +64,18 @@
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
 #include <string>
-#include <list>
+#include <vector>
 #include <memory>
 #include <mutex>
+#include <atomic>
+#include <cstdint>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
 #include "rrlib/logging/log_levels.h"
 #include "rrlib/logging/messages/tFanOutBuffer.h"
+#include "rrlib/logging/messages/tPrefixTemplate.h"
 #include "rrlib/logging/sinks/tSink.h"
 #include "rrlib/logging/sinks/tStream.h"
 
@@ -140,9 +143,28 @@ public:
     return this->name;
   }
 
-  inline const std::string GetFullQualifiedName() const
+  inline const std::string &GetFullQualifiedName() const
   {
-    return (this->parent && this->parent->parent ? this->parent->GetFullQualifiedName() : "") + "." + this->Name();
+    return this->full_qualified_name;
+  }
+
+  /*! Get the full qualified name padded with spaces
+   *
+   * The padded rendering is created once and reused until a longer
+   * width is requested, e.g. when a domain with longer name was added.
+   *
+   * \param width   The width the name should be padded to (a separating space is appended)
+   *
+   * \returns The full qualified name followed by spaces up to the given width plus one
+   */
+  inline const std::string &GetPaddedFullQualifiedName(size_t width) const
+  {
+    const std::string *padded_name = this->padded_full_qualified_name.load(std::memory_order_acquire);
+    if (!padded_name || padded_name->length() < width + 1)
+    {
+      padded_name = this->PreparePaddedFullQualifiedName(width);
+    }
+    return *padded_name;
   }
 
   void SetPrintsName(bool value);
@@ -151,67 +173,174 @@ public:
   void SetPrintsLocation(bool value);
   void SetMaxMessageLevel(tLogLevel level);
   void ClearSinks();
+
+  /*! Set the template for the prefix of messages (see tPrefixTemplate)
+   *
+   * \param prefix_template   The template or an empty string to use the prints_* settings
+   */
+  void SetPrefixTemplate(const std::string &prefix_template);
   void AddSink(std::shared_ptr<sinks::tSink> sink);
 
   inline bool PrintsName() const
   {
-    return this->prints_name;
+    return this->EffectiveSettings() & (1 << static_cast<int>(tSetting::PRINTS_NAME));
   }
 
   inline bool PrintsTime() const
   {
-    return this->prints_time;
+    return this->EffectiveSettings() & (1 << static_cast<int>(tSetting::PRINTS_TIME));
   }
 
   inline bool PrintsLevel() const
   {
-    return this->prints_level;
+    return this->EffectiveSettings() & (1 << static_cast<int>(tSetting::PRINTS_LEVEL));
   }
 
   inline bool PrintsLocation() const
   {
-    return this->prints_location;
+    return this->EffectiveSettings() & (1 << static_cast<int>(tSetting::PRINTS_LOCATION));
   }
 
   inline const tLogLevel MaxMessageLevel() const
   {
-    return this->max_message_level;
+    return static_cast<tLogLevel>(this->EffectiveSettings() >> static_cast<int>(tSetting::MAX_MESSAGE_LEVEL));
   }
 
+  /*! Get the template for the prefix of messages in this domain
+   *
+   * The template is resolved from the explicitly set templates and the
+   * prints_* settings again whenever they change in this domain or one
+   * of its ancestors.
+   *
+   * \returns The compiled prefix template
+   */
+  inline const tPrefixTemplate &PrefixTemplate() const
+  {
+    if (this->prefix_template_generation.load(std::memory_order_acquire) != this->settings_generation.load(std::memory_order_acquire))
+    {
+      return *this->ResolvePrefixTemplate();
+    }
+    return *this->prefix_template.load(std::memory_order_acquire);
+  }
+
+  /*! Get the stream buffer that fans out messages to the sinks of this domain
+   *
+   * The buffer is (re)built from the current sinks under the lock of
+   * tStream if the sinks of this domain or one of its ancestors changed. Hence, this method must not be
+   * called while holding that lock.
+   *
+   * \returns The stream buffer of this domain
+   */
   inline tFanOutBuffer &StreamBuffer() const
   {
-    if (!this->stream_buffer_ready)
+    if (this->stream_buffer_generation.load(std::memory_order_acquire) != this->sinks_generation.load(std::memory_order_acquire))
     {
       this->PrepareStreamBuffer();
     }
     return this->stream_buffer;
   }
 
-  inline const std::list<tConfiguration *> &Children() const
+  /*! Get the children of this configuration
+   *
+   * As other threads might add new children at any time, this method
+   * returns a snapshot of the current list, sorted longest name first.
+   *
+   * \returns A copy of the current list of children
+   */
+  inline std::vector<tConfiguration *> Children() const
   {
+    std::lock_guard<std::mutex> lock(this->children_mutex);
     return this->children;
   }
 
+  /*! Get the current structure epoch of the configuration tree
+   *
+   * The epoch changes whenever references into the tree that were
+   * cached outside (e.g. by tConfigurationHandle) become invalid, i.e.
+   * when the registry is destroyed or rebuilt. Changing settings does
+   * not affect it, as those are validated per domain.
+   *
+   * \returns The current structure epoch of the configuration tree
+   */
+  static inline unsigned int StructureEpoch()
+  {
+    return structure_epoch.load(std::memory_order_acquire);
+  }
+
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
 private:
 
+  static std::atomic<unsigned int> structure_epoch;
+  static std::atomic<unsigned int> last_change;  // Orders changes of overrides, sinks and prefix templates
+
+  typedef std::vector<std::shared_ptr<sinks::tSink>> tSinks;
+  typedef std::vector<std::pair<unsigned int, std::shared_ptr<sinks::tSink>>> tAddedSinks;
+
+  /*! The settings that are inherited from ancestors unless explicitly set
+   *
+   * The values are also used as bit positions in the packed effective
+   * settings (flags first, the message level in the remaining bits).
+   */
+  enum class tSetting
+  {
+    PRINTS_NAME,
+    PRINTS_TIME,
+    PRINTS_LEVEL,
+    PRINTS_LOCATION,
+    MAX_MESSAGE_LEVEL,
+    DIMENSION
+  };
+
   const tConfiguration *parent;
   std::string name;
+  std::string full_qualified_name;
+  mutable std::atomic<const std::string *> padded_full_qualified_name;
+  mutable std::vector<std::unique_ptr<const std::string>> padded_full_qualified_names;
+
+  // Changed whenever settings or sinks of this domain or one of its ancestors change
+  std::atomic<unsigned int> settings_generation;
+  std::atomic<unsigned int> sinks_generation;
 
-  bool prints_name;
-  bool prints_time;
-  bool prints_level;
-  bool prints_location;
+  // Explicitly set values packed with the timestamp of the change (timestamp << 8 | value). The latest along the path from the root wins
+  std::atomic<uint64_t> overrides[static_cast<size_t>(tSetting::DIMENSION)];
+  mutable std::atomic<uint64_t> effective_settings;  // settings_generation << 32 | packed settings
 
-  tLogLevel max_message_level;
+  // Sinks added explicitly with their timestamps. Only sinks added after the latest ClearSinks along the path from the root are used
+  std::shared_ptr<const tAddedSinks> added_sinks;  // only accessed via std::atomic_load and std::atomic_store
+  std::atomic<unsigned int> sinks_cleared;
 
-  std::vector<std::shared_ptr<sinks::tSink>> sinks;
-  mutable bool stream_buffer_ready;
+  // The prefix template set explicitly with its timestamp. Replaced overrides are kept as concurrent printers might still use them
+  struct tPrefixTemplateOverride
+  {
+    unsigned int timestamp;
+    std::unique_ptr<const tPrefixTemplate> prefix_template;  // empty to use the prints_* settings
+  };
+  std::atomic<const tPrefixTemplateOverride *> prefix_template_override;
+  std::vector<std::unique_ptr<const tPrefixTemplateOverride>> prefix_template_overrides;
+
+  mutable std::atomic<unsigned int> prefix_template_generation;
+  mutable std::atomic<const tPrefixTemplate *> prefix_template;
+
+  mutable std::atomic<unsigned int> stream_buffer_generation;
+  mutable std::shared_ptr<const tSinks> stream_buffer_sinks;
   mutable tFanOutBuffer stream_buffer;
 
-  mutable std::list<tConfiguration *> children;
+  /*! Open addressed hash index of children that is published to lock-free readers */
+  struct tChildrenIndex
+  {
+    const size_t mask;
+    std::unique_ptr<std::atomic<tConfiguration *>[]> slots;
+
+    explicit tChildrenIndex(size_t size);
+  };
+
+  size_t name_hash;
+
+  mutable std::vector<tConfiguration *> children;
+  mutable std::atomic<tChildrenIndex *> children_index;
+  mutable std::vector<std::unique_ptr<tChildrenIndex>> children_indices;
   mutable std::mutex children_mutex;
 
   tConfiguration(const tDefaultConfigurationContext &default_context, const tConfiguration *parent, const std::string &name);
@@ -228,10 +357,32 @@ private:
 
   tConfiguration *FindChild(const char *name, size_t length) const;
 
-  std::list<tConfiguration *>::iterator FindInsertionPoint(size_t length) const;
+  void InsertChild(tConfiguration *child) const;
+
+  inline unsigned int EffectiveSettings() const
+  {
+    const uint64_t settings = this->effective_settings.load(std::memory_order_relaxed);
+    if (static_cast<unsigned int>(settings >> 32) != this->settings_generation.load(std::memory_order_acquire))
+    {
+      return this->ResolveSettings();
+    }
+    return static_cast<unsigned int>(settings);
+  }
+
+  unsigned int ResolveSettings() const;
+
+  std::shared_ptr<const tSinks> ResolveSinks() const;
+
+  const tPrefixTemplate *ResolvePrefixTemplate() const;
+
+  void SetOverride(tSetting setting, unsigned int value);
+
+  void InvalidateSubtree(std::atomic<unsigned int> tConfiguration::*subtree_generation);
 
   void PrepareStreamBuffer() const;
 
+  const std::string *PreparePaddedFullQualifiedName(size_t width) const;
+
 };
 
 //----------------------------------------------------------------------
@@ -0,0 +1,93 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/logging/configuration/tConfigurationHandle.cpp
+ *
+ * \author  Tobias Föhst
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#define __rrlib__logging__include_guard__
+#include "rrlib/logging/configuration/tConfigurationHandle.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/logging/configuration/tDomainRegistry.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace logging
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// tConfigurationHandle Resolve
+//----------------------------------------------------------------------
+void tConfigurationHandle::Resolve()
+{
+  // Creating the registry changes the epoch. Read it afterwards, but before looking up the configuration. If the tree is rebuilt meanwhile, we just resolve again next time
+  tDomainRegistryImplementation &domain_registry = tDomainRegistry::Instance();
+  const unsigned int structure_epoch = tConfiguration::StructureEpoch();
+  if (this->source_relative_filename)
+  {
+    this->configuration.store(&domain_registry.GetConfigurationBySourceRelativeFilename(*this->default_context, this->source_relative_filename, this->domain_name), std::memory_order_relaxed);
+  }
+  else
+  {
+    this->configuration.store(&domain_registry.GetConfiguration(*this->default_context, this->filename, this->domain_name), std::memory_order_relaxed);
+  }
+  this->structure_epoch.store(structure_epoch, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,184 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/logging/configuration/tConfigurationHandle.h
+ *
+ * \author  Tobias Föhst
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tConfigurationHandle
+ *
+ * \b tConfigurationHandle
+ *
+ * tConfigurationHandle caches the configuration that belongs to one
+ * call site of the logging macros. It is meant to be used as function
+ * local static object and resolves its configuration via the domain
+ * registry on first use. Afterwards, the lookup costs one load and a
+ * comparison of the structure epoch, also while domains are
+ * reconfigured.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__logging__include_guard__
+#error Invalid include directive. Try #include "rrlib/logging/configuration.h" instead.
+#endif
+
+#ifndef __rrlib__logging__configuration__tConfigurationHandle_h__
+#define __rrlib__logging__configuration__tConfigurationHandle_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/logging/configuration/tConfiguration.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace logging
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+namespace internal
+{
+constexpr const char *StripSourceRootRemainder(const char *filename, const char *source_root)
+{
+  return *source_root == 0 ? (*filename == '/' ? filename + 1 : (filename[-1] == '/' ? filename : nullptr)) :
+         (*filename == *source_root ? StripSourceRootRemainder(filename + 1, source_root + 1) : nullptr);
+}
+}
+
+/*! Strip a source root directory from a filename at compile time
+ *
+ * If the build system provides the root of the source tree (e.g. via
+ * RRLIB_LOGGING_SOURCE_ROOT) the source relative part of __FILE__ can be
+ * determined at compile time. That way, the entries of RRLIB_LOGGING_PATH
+ * do not have to be matched at runtime.
+ *
+ * \param filename      The filename to be stripped (typically __FILE__)
+ * \param source_root   The root directory of the source tree (with or without trailing slash)
+ *
+ * \returns The part of filename relative to source_root or zero if filename is not located in source_root
+ */
+constexpr const char *StripSourceRoot(const char *filename, const char *source_root)
+{
+  return *source_root == 0 ? nullptr : internal::StripSourceRootRemainder(filename, source_root);
+}
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! A cached reference to the configuration of one call site
+/*! Looking up the configuration for a given filename or domain name
+ *  means walking the domain tree. As the result does not change for a
+ *  specific call site, it can be stored in a function local static
+ *  instance of this class and reused for every following message.
+ *
+ *  The cached reference is validated against the structure epoch of
+ *  the configuration tree, which only changes when the domain registry
+ *  is destroyed or resurrected. Changing the settings of domains keeps
+ *  the reference valid, as the configuration resolves them itself.
+ *
+ *  The constructor is constexpr, so that static instances are
+ *  initialized at compile time without a guard variable.
+ */
+class tConfigurationHandle
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! The ctor of tConfigurationHandle
+   *
+   * \param filename                   The file the call site is located in (typically __FILE__)
+   * \param domain_name                An optional explicitly specified domain name
+   * \param source_relative_filename   The filename relative to the source tree if known at compile time (see StripSourceRoot)
+   * \param default_context            The context used to create new configurations
+   */
+  constexpr tConfigurationHandle(const char *filename, const char *domain_name = 0, const char *source_relative_filename = 0, const tDefaultConfigurationContext &default_context = cDEFAULT_CONTEXT)
+    : filename(filename),
+      domain_name(domain_name),
+      source_relative_filename(source_relative_filename),
+      default_context(&default_context),
+      configuration(nullptr),
+      structure_epoch(0)
+  {}
+
+  /*! Get the configuration of this call site
+   *
+   * The configuration is looked up in the domain registry on first use
+   * or if the configuration tree was rebuilt since the last lookup.
+   *
+   * \returns The configuration that belongs to this call site
+   */
+  inline const tConfiguration &Get()
+  {
+    if (this->structure_epoch.load(std::memory_order_acquire) != tConfiguration::StructureEpoch())
+    {
+      this->Resolve();
+    }
+    return *this->configuration.load(std::memory_order_relaxed);
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  const char *filename;
+  const char *domain_name;
+  const char *source_relative_filename;
+  const tDefaultConfigurationContext *default_context;
+
+  std::atomic<const tConfiguration *> configuration;
+  std::atomic<unsigned int> structure_epoch;
+
+  tConfigurationHandle(const tConfigurationHandle &other);
+
+  tConfigurationHandle &operator = (const tConfigurationHandle &other);
+
+  void Resolve();
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
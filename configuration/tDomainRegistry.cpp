@@ -34,6 +34,7 @@
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
 #include <cstdlib>
+#include <cstdint>
 #include <algorithm>
 #include <cstring>
 #include <sstream>
@@ -72,19 +73,44 @@ namespace logging
 //----------------------------------------------------------------------
 // Const values
 //----------------------------------------------------------------------
+const size_t cINITIAL_LOOKUP_CACHE_SIZE = 64;
+const size_t cMAX_LOOKUP_CACHE_ENTRIES = 4096;
+#ifdef RRLIB_LOGGING_CLASSIC_FORMATTING
+const bool cDEFAULT_CLASSIC_FORMATTING = true;
+#else
+const bool cDEFAULT_CLASSIC_FORMATTING = false;
+#endif
 
 //----------------------------------------------------------------------
 // Implementation
 //----------------------------------------------------------------------
 
+namespace
+{
+size_t HashPointers(const char *filename, const char *domain_name)
+{
+  // Finalizer of MurmurHash3 to spread the addresses over all bits
+  uint64_t value = reinterpret_cast<uintptr_t>(filename) ^ (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(domain_name)) << 1);
+  value ^= value >> 33;
+  value *= 0xff51afd7ed558ccdull;
+  value ^= value >> 33;
+  value *= 0xc4ceb9fe1a85ec53ull;
+  value ^= value >> 33;
+  return static_cast<size_t>(value);
+}
+}
+
 //----------------------------------------------------------------------
 // tDomainRegistryImplementation constructors
 //----------------------------------------------------------------------
 tDomainRegistryImplementation::tDomainRegistryImplementation()
   : global_configuration(new tConfiguration(cDEFAULT_CONTEXT, 0, "")),
+    frozen_domain_table(NULL),
     max_domain_name_length(0),
     pad_prefix_columns(true),
-    pad_multi_line_messages(true)
+    pad_multi_line_messages(true),
+    classic_formatting(cDEFAULT_CLASSIC_FORMATTING),
+    lookup_cache(NULL)
 {
   // Look at the environment variable RRLIB_LOGGING_PATH or a default value and let p point to its beginning
   const char *rrlib_logging_path = std::getenv("RRLIB_LOGGING_PATH");
@@ -120,6 +146,25 @@ tDomainRegistryImplementation::tDomainRegistryImplementation()
 #endif
 #endif
 
+  // A new tree invalidates references cached from a former registry instance (resurrection)
+  tConfiguration::structure_epoch++;
+}
+
+tDomainRegistryImplementation::tLookupCacheEntry::tLookupCacheEntry(const char *filename, const char *domain_name)
+  : filename(filename),
+    domain_name(domain_name),
+    configuration(NULL)
+{}
+
+tDomainRegistryImplementation::tLookupCache::tLookupCache(size_t size)
+  : mask(size - 1),
+    slots(new std::atomic<const tLookupCacheEntry *>[size])
+{
+  assert((size & this->mask) == 0 && "size must be a power of two");
+  for (size_t i = 0; i < size; ++i)
+  {
+    this->slots[i].store(NULL, std::memory_order_relaxed);
+  }
 }
 
 //----------------------------------------------------------------------
@@ -127,6 +172,7 @@ tDomainRegistryImplementation::tDomainRegistryImplementation()
 //----------------------------------------------------------------------
 tDomainRegistryImplementation::~tDomainRegistryImplementation()
 {
+  tConfiguration::structure_epoch++;
   delete this->global_configuration;
 }
 
@@ -135,17 +181,79 @@ tDomainRegistryImplementation::~tDomainRegistryImplementation()
 //----------------------------------------------------------------------
 const tConfiguration &tDomainRegistryImplementation::GetConfiguration(const tDefaultConfigurationContext &default_context, const char *filename, const char *domain_name)
 {
+  const tLookupCacheEntry *cached_entry = this->FindLookupCacheEntry(filename, domain_name);
+  if (cached_entry)
+  {
+    if (cached_entry->error)
+    {
+      throw *cached_entry->error;
+    }
+    return *cached_entry->configuration;
+  }
+
+  tLookupCacheEntry entry(filename, domain_name);
+  if (domain_name && domain_name[0] == '.')
+  {
+    entry.configuration = &this->GetConfigurationBySourceRelativeFilename(default_context, NULL, domain_name);
+  }
+  else
+  {
+    const char *source_relative_filename = NULL;
+    try
+    {
+      source_relative_filename = this->StripLoggingPathPrefix(filename);
+    }
+    catch (const std::runtime_error &exception)
+    {
+      // Remember that this file is not in RRLIB_LOGGING_PATH to not build the same message again
+      entry.error = std::make_shared<const std::runtime_error>(exception);
+      this->AddLookupCacheEntry(entry);
+      throw;
+    }
+    entry.configuration = &this->GetConfigurationBySourceRelativeFilename(default_context, source_relative_filename, domain_name);
+  }
+  this->AddLookupCacheEntry(entry);
+  return *entry.configuration;
+}
+
+//----------------------------------------------------------------------
+// tDomainRegistryImplementation GetConfigurationBySourceRelativeFilename
+//----------------------------------------------------------------------
+const tConfiguration &tDomainRegistryImplementation::GetConfigurationBySourceRelativeFilename(const tDefaultConfigurationContext &default_context, const char *filename, const char *domain_name)
+{
+  assert(this->global_configuration);
+  const tFrozenDomainTable *frozen_domain_table = this->frozen_domain_table.load(std::memory_order_acquire);
+  if (frozen_domain_table)
+  {
+    const tConfiguration *configuration = frozen_domain_table->Find(filename, domain_name);
+    if (configuration)
+    {
+      return *configuration;
+    }
+  }
   if (domain_name)
   {
     assert(*domain_name && "domain_name must be zero or not empty!");
     if (domain_name[0] == '.')
     {
-      assert(this->global_configuration);
       return (domain_name[1] == 0) ? *this->global_configuration : this->global_configuration->GetConfigurationByName(default_context, domain_name + 1);
     }
-    return tDomainRegistry::Instance().GetConfigurationByFilename(default_context, filename).GetConfigurationByName(default_context, domain_name);
+    return this->global_configuration->GetConfigurationByFilename(default_context, filename).GetConfigurationByName(default_context, domain_name);
   }
-  return tDomainRegistry::Instance().GetConfigurationByFilename(default_context, filename);
+  return this->global_configuration->GetConfigurationByFilename(default_context, filename);
+}
+
+//----------------------------------------------------------------------
+// tDomainRegistryImplementation Freeze
+//----------------------------------------------------------------------
+void tDomainRegistryImplementation::Freeze()
+{
+  std::unique_ptr<const tFrozenDomainTable> frozen_domain_table(new tFrozenDomainTable(*this->global_configuration));
+
+  // Former tables are kept as concurrent lookups might still use them
+  std::lock_guard<std::mutex> lock(this->frozen_domain_tables_mutex);
+  this->frozen_domain_table.store(frozen_domain_table.get(), std::memory_order_release);
+  this->frozen_domain_tables.push_back(std::move(frozen_domain_table));
 }
 
 //----------------------------------------------------------------------
@@ -174,16 +282,17 @@ const std::string &tDomainRegistryImplementation::LogFilenamePrefix() const
 //----------------------------------------------------------------------
 void tDomainRegistryImplementation::UpdateMaxDomainNameLength(size_t added_domain_name_length)
 {
-  this->max_domain_name_length = std::max(this->max_domain_name_length, added_domain_name_length);
+  // Domains are added concurrently below different parents
+  size_t current_length = this->max_domain_name_length.load(std::memory_order_relaxed);
+  while (current_length < added_domain_name_length && !this->max_domain_name_length.compare_exchange_weak(current_length, added_domain_name_length, std::memory_order_relaxed))
+  {}
 }
 
 //----------------------------------------------------------------------
-// tDomainRegistryImplementation GetConfigurationByFilename
+// tDomainRegistryImplementation StripLoggingPathPrefix
 //----------------------------------------------------------------------
-const tConfiguration &tDomainRegistryImplementation::GetConfigurationByFilename(const tDefaultConfigurationContext &default_context, const char *filename) const
+const char *tDomainRegistryImplementation::StripLoggingPathPrefix(const char *filename) const
 {
-  bool found_prefix = false;
-
   // Iterate over sorted list of RRLIB_LOG_PATH components
   for (auto it = this->rrlib_logging_path_entries.begin(); it != this->rrlib_logging_path_entries.end(); ++it)
   {
@@ -198,23 +307,89 @@ const tConfiguration &tDomainRegistryImplementation::GetConfigurationByFilename(
     // Due to the longest-first sorted list the first match terminates our search
     if (std::strncmp(filename, it->c_str(), length) == 0)
     {
-      filename = filename + length + 1;
-      found_prefix = true;
-      break;
+      return filename + length + 1;
     }
   }
 
-  if (!found_prefix && !this->rrlib_logging_path_entries.back().empty())
+  if (!this->rrlib_logging_path_entries.back().empty())
   {
     std::stringstream message;
     message << "'" << filename << "' is not in RRLIB_LOGGING_PATH";
     throw std::runtime_error(message.str());
   }
 
-  assert(this->global_configuration);
-  return this->global_configuration->GetConfigurationByFilename(default_context, filename);
+  return filename;
 }
 
+//----------------------------------------------------------------------
+// tDomainRegistryImplementation FindLookupCacheEntry
+//----------------------------------------------------------------------
+const tDomainRegistryImplementation::tLookupCacheEntry *tDomainRegistryImplementation::FindLookupCacheEntry(const char *filename, const char *domain_name) const
+{
+  // Lock-free lookup: caches are only published completely filled and slots are only changed from empty to final
+  const tLookupCache *cache = this->lookup_cache.load(std::memory_order_acquire);
+  if (!cache)
+  {
+    return NULL;
+  }
+
+  // Linear probing in open addressed hash table (size is a power of two)
+  for (size_t i = HashPointers(filename, domain_name) & cache->mask;; i = (i + 1) & cache->mask)
+  {
+    const tLookupCacheEntry *candidate = cache->slots[i].load(std::memory_order_acquire);
+    if (!candidate)
+    {
+      return NULL;
+    }
+    if (candidate->filename == filename && candidate->domain_name == domain_name)
+    {
+      return candidate;
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+// tDomainRegistryImplementation AddLookupCacheEntry
+//----------------------------------------------------------------------
+void tDomainRegistryImplementation::AddLookupCacheEntry(const tLookupCacheEntry &entry)
+{
+  std::lock_guard<std::mutex> lock(this->lookup_cache_mutex);
+
+  // Callers that pass dynamically created strings must not let the cache grow unbounded
+  if (this->lookup_cache_entries.size() >= cMAX_LOOKUP_CACHE_ENTRIES || this->FindLookupCacheEntry(entry.filename, entry.domain_name))
+  {
+    return;
+  }
+  this->lookup_cache_entries.emplace_back(new tLookupCacheEntry(entry));
+
+  // Keep load factor at most 1/2. A grown cache is filled completely before being published
+  tLookupCache *cache = this->lookup_cache.load(std::memory_order_relaxed);
+  if (!cache || 2 * this->lookup_cache_entries.size() > cache->mask + 1)
+  {
+    size_t size = cache ? 2 * (cache->mask + 1) : cINITIAL_LOOKUP_CACHE_SIZE;
+    cache = new tLookupCache(size);
+    this->lookup_caches.emplace_back(cache);
+    for (auto it = this->lookup_cache_entries.begin(); it != this->lookup_cache_entries.end(); ++it)
+    {
+      size_t i = HashPointers((*it)->filename, (*it)->domain_name) & cache->mask;
+      while (cache->slots[i].load(std::memory_order_relaxed))
+      {
+        i = (i + 1) & cache->mask;
+      }
+      cache->slots[i].store(it->get(), std::memory_order_relaxed);
+    }
+    this->lookup_cache.store(cache, std::memory_order_release);
+    return;
+  }
+
+  const tLookupCacheEntry *new_entry = this->lookup_cache_entries.back().get();
+  size_t i = HashPointers(new_entry->filename, new_entry->domain_name) & cache->mask;
+  while (cache->slots[i].load(std::memory_order_relaxed))
+  {
+    i = (i + 1) & cache->mask;
+  }
+  cache->slots[i].store(new_entry, std::memory_order_release);
+}
 
 //----------------------------------------------------------------------
 // End of namespace declaration
@@ -53,6 +53,8 @@
 //#include <string>
 #include <vector>
 #include <iostream>
+#include <atomic>
+#include <stdexcept>
 
 #include "rrlib/design_patterns/singleton.h"
 
@@ -65,6 +67,7 @@
 //----------------------------------------------------------------------
 #include "rrlib/logging/configuration/DomainRegistryLifetime.h"
 #include "rrlib/logging/configuration/tConfiguration.h"
+#include "rrlib/logging/configuration/tFrozenDomainTable.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -117,8 +120,52 @@ public:
    */
   ~tDomainRegistryImplementation();
 
+  /*! Get the configuration for a given filename and domain name
+   *
+   * Results are cached by the addresses of filename and domain_name.
+   * Thus, repeated lookups from the same call site cost one probe into
+   * a lock-free hash table, including the ones for files that are not
+   * located in RRLIB_LOGGING_PATH. Strings at other addresses are
+   * resolved by their content and cached under their own addresses.
+   * Therefore, both must point to strings that do not change as long
+   * as the registry exists (e.g. __FILE__ or other string literals).
+   * Names in temporary buffers have to be looked up via
+   * GetConfigurationBySourceRelativeFilename.
+   *
+   * \param default_context   The context used to create new configurations
+   * \param filename          The file to get the configuration for (typically __FILE__, may be zero for absolute domain names)
+   * \param domain_name       An optional explicitly specified domain name
+   *
+   * \returns The configuration for the given file or domain
+   * \throws std::runtime_error if filename is not located in RRLIB_LOGGING_PATH
+   */
   const tConfiguration &GetConfiguration(const tDefaultConfigurationContext &default_context, const char *filename, const char *domain_name = 0);
 
+  /*! Get the configuration for a filename that is already relative to the source tree
+   *
+   * In contrast to GetConfiguration, the given filename is not matched
+   * against the entries of RRLIB_LOGGING_PATH. It must already be
+   * relative to one of these entries, e.g. because it was stripped at
+   * compile time (see RRLIB_LOGGING_SOURCE_ROOT).
+   *
+   * \param default_context   The context used to create new configurations
+   * \param filename          The source relative filename (may be zero for absolute domain names)
+   * \param domain_name       An optional explicitly specified domain name
+   *
+   * \returns The configuration for the given file or domain
+   */
+  const tConfiguration &GetConfigurationBySourceRelativeFilename(const tDefaultConfigurationContext &default_context, const char *filename, const char *domain_name = 0);
+
+  /*! Compile the current domain tree into a flat lookup table
+   *
+   * Once the set of domains does not change anymore (e.g. after startup)
+   * the tree can be frozen into a table with perfect hashing. Afterwards,
+   * lookups are answered from that table and only unknown domains are
+   * looked up in (and added to) the tree. Freezing again rebuilds the
+   * table from the current tree.
+   */
+  void Freeze();
+
   /*! Set a prefix for filenames that are created as log
    *
    * If their output stream is set to eMS_FILE domains create a log
@@ -191,6 +238,29 @@ public:
     return this->pad_multi_line_messages;
   }
 
+  /*! Set if messages should be formatted independent of the global locale
+   *
+   * Numbers in log messages are usually parsed by tools, so locale
+   * dependent separators are unwanted. With this flag set, tStream
+   * formats with the classic "C" locale and does not consult the locale
+   * facets for numbers at all.
+   *
+   * \param value   The new value of this flag
+   */
+  inline void SetClassicFormatting(bool value)
+  {
+    this->classic_formatting = value;
+  }
+
+  /*! Get if messages should be formatted independent of the global locale
+   *
+   * \returns Whether messages are formatted using the classic "C" locale
+   */
+  inline bool GetClassicFormatting() const
+  {
+    return this->classic_formatting;
+  }
+
   void UpdateMaxDomainNameLength(size_t added_domain_name_length);
 
   /*! Get the length of the longest full qualified domain name
@@ -201,7 +271,7 @@ public:
    */
   inline size_t MaxDomainNameLength() const
   {
-    return this->max_domain_name_length;
+    return this->max_domain_name_length.load(std::memory_order_relaxed);
   }
 
 //----------------------------------------------------------------------
@@ -213,12 +283,46 @@ private:
 
   mutable tConfiguration *global_configuration;
 
+  std::atomic<const tFrozenDomainTable *> frozen_domain_table;
+  std::vector<std::unique_ptr<const tFrozenDomainTable>> frozen_domain_tables;
+  std::mutex frozen_domain_tables_mutex;
+
   std::string log_filename_prefix;
-  size_t max_domain_name_length;
+  std::atomic<size_t> max_domain_name_length;
   bool pad_prefix_columns;
   bool pad_multi_line_messages;
+  bool classic_formatting;
+
+  /*! A resolved lookup of GetConfiguration (either a configuration or the error to be thrown) */
+  struct tLookupCacheEntry
+  {
+    const char *filename;
+    const char *domain_name;
+    const tConfiguration *configuration;
+    std::shared_ptr<const std::runtime_error> error;
+
+    tLookupCacheEntry(const char *filename, const char *domain_name);
+  };
+
+  /*! Open addressed hash table of lookup cache entries that is published to lock-free readers */
+  struct tLookupCache
+  {
+    const size_t mask;
+    std::unique_ptr<std::atomic<const tLookupCacheEntry *>[]> slots;
+
+    explicit tLookupCache(size_t size);
+  };
+
+  std::atomic<tLookupCache *> lookup_cache;
+  std::vector<std::unique_ptr<tLookupCache>> lookup_caches;
+  std::vector<std::unique_ptr<const tLookupCacheEntry>> lookup_cache_entries;
+  std::mutex lookup_cache_mutex;
+
+  const char *StripLoggingPathPrefix(const char *filename) const;
+
+  const tLookupCacheEntry *FindLookupCacheEntry(const char *filename, const char *domain_name) const;
 
-  const tConfiguration &GetConfigurationByFilename(const tDefaultConfigurationContext &default_context, const char *filename) const;
+  void AddLookupCacheEntry(const tLookupCacheEntry &entry);
 
 };
 
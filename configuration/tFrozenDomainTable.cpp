@@ -0,0 +1,293 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/logging/configuration/tFrozenDomainTable.cpp
+ *
+ * \author  Tobias Föhst
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#define __rrlib__logging__include_guard__
+#include "rrlib/logging/configuration/tFrozenDomainTable.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstring>
+#include <algorithm>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace logging
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+const size_t cKEYS_PER_BUCKET = 4;
+const uint64_t cMAX_DISPLACEMENT = 1 << 16;
+const unsigned int cMAX_BUILD_ATTEMPTS = 8;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+namespace
+{
+inline uint64_t HashAppend(uint64_t hash, char c)
+{
+  // FNV-1a (64 bit)
+  return (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+}
+
+inline uint64_t HashBegin()
+{
+  return 14695981039346656037ull;
+}
+
+inline size_t Bucket(uint64_t hash, size_t bucket_mask)
+{
+  return (hash >> 32) & bucket_mask;
+}
+
+inline size_t Slot(uint64_t hash, uint64_t displacement, uint64_t mask)
+{
+  // Finalizer of MurmurHash3 to spread the displaced hash over all bits
+  uint64_t value = hash ^ displacement;
+  value ^= value >> 33;
+  value *= 0xff51afd7ed558ccdull;
+  value ^= value >> 33;
+  value *= 0xc4ceb9fe1a85ec53ull;
+  value ^= value >> 33;
+  return value & mask;
+}
+
+size_t NextPowerOfTwo(size_t value)
+{
+  size_t result = 1;
+  while (result < value)
+  {
+    result <<= 1;
+  }
+  return result;
+}
+}
+
+//----------------------------------------------------------------------
+// tFrozenDomainTable constructors
+//----------------------------------------------------------------------
+tFrozenDomainTable::tFrozenDomainTable(const tConfiguration &root)
+  : size(0),
+    mask(0),
+    displacements(1, 0),
+    entries(1, tEntry {0, 0, 0, NULL})
+{
+  std::vector<tEntry> table_entries;
+  std::vector<const tConfiguration *> pending(1, &root);
+  while (!pending.empty())
+  {
+    const tConfiguration *configuration = pending.back();
+    pending.pop_back();
+
+    // Domains created from directory names might contain dots, which makes their full qualified names ambiguous. These are left to the tree
+    if (configuration->Name().find('.') != std::string::npos)
+    {
+      continue;
+    }
+
+    const std::string &key = configuration->GetFullQualifiedName();
+    uint64_t hash = HashBegin();
+    for (auto it = key.begin(); it != key.end(); ++it)
+    {
+      hash = HashAppend(hash, *it);
+    }
+    table_entries.push_back(tEntry {hash, static_cast<uint32_t>(this->keys.length()), static_cast<uint32_t>(key.length()), configuration});
+    this->keys.append(key);
+
+    const std::vector<tConfiguration *> children(configuration->Children());
+    pending.insert(pending.end(), children.begin(), children.end());
+  }
+
+  // If no perfect hash function is found (e.g. due to colliding hashes) the table stays empty and all lookups use the tree
+  size_t table_size = NextPowerOfTwo(table_entries.size() + table_entries.size() / 4);
+  for (unsigned int attempt = 0; attempt < cMAX_BUILD_ATTEMPTS && !this->Build(table_entries, table_size); ++attempt)
+  {
+    table_size <<= 1;
+  }
+}
+
+//----------------------------------------------------------------------
+// tFrozenDomainTable Build
+//----------------------------------------------------------------------
+bool tFrozenDomainTable::Build(const std::vector<tEntry> &table_entries, size_t table_size)
+{
+  const size_t bucket_count = NextPowerOfTwo(std::max<size_t>(1, table_entries.size() / cKEYS_PER_BUCKET));
+  std::vector<std::vector<size_t>> buckets(bucket_count);
+  for (size_t i = 0; i < table_entries.size(); ++i)
+  {
+    buckets[Bucket(table_entries[i].hash, bucket_count - 1)].push_back(i);
+  }
+
+  // Place large buckets first while the table is still sparse
+  std::vector<size_t> order(bucket_count);
+  for (size_t i = 0; i < bucket_count; ++i)
+  {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&buckets](size_t a, size_t b)
+  {
+    return buckets[a].size() > buckets[b].size();
+  });
+
+  std::vector<uint64_t> displacements(bucket_count, 0);
+  std::vector<tEntry> entries(table_size, tEntry {0, 0, 0, NULL});
+  std::vector<size_t> slots;
+  for (auto it = order.begin(); it != order.end() && !buckets[*it].empty(); ++it)
+  {
+    const std::vector<size_t> &bucket = buckets[*it];
+    for (uint64_t displacement = 1; slots.size() != bucket.size(); ++displacement)
+    {
+      if (displacement > cMAX_DISPLACEMENT)
+      {
+        return false;
+      }
+
+      slots.clear();
+      for (auto key = bucket.begin(); key != bucket.end(); ++key)
+      {
+        const size_t slot = Slot(table_entries[*key].hash, displacement, table_size - 1);
+        if (entries[slot].configuration || std::find(slots.begin(), slots.end(), slot) != slots.end())
+        {
+          break;
+        }
+        slots.push_back(slot);
+      }
+
+      if (slots.size() == bucket.size())
+      {
+        displacements[*it] = displacement;
+        for (size_t i = 0; i < bucket.size(); ++i)
+        {
+          entries[slots[i]] = table_entries[bucket[i]];
+        }
+      }
+    }
+    slots.clear();
+  }
+
+  this->size = table_entries.size();
+  this->mask = table_size - 1;
+  this->displacements.swap(displacements);
+  this->entries.swap(entries);
+  return true;
+}
+
+//----------------------------------------------------------------------
+// tFrozenDomainTable Find
+//----------------------------------------------------------------------
+const tConfiguration *tFrozenDomainTable::Find(const char *filename, const char *domain_name) const
+{
+  const char *directory = filename;
+  size_t directory_length = 0;
+  if (domain_name && domain_name[0] == '.')
+  {
+    domain_name++;
+  }
+  else if (filename)
+  {
+    const char *delimiter = std::strrchr(filename, '/');
+    directory_length = delimiter ? delimiter - filename : 0;
+  }
+  const size_t domain_name_length = domain_name ? std::strlen(domain_name) : 0;
+  const bool needs_separator = directory_length && domain_name_length;
+
+  // The key is the full qualified name, i.e. the directory with '/' mapped to '.' followed by the domain name
+  uint64_t hash = HashAppend(HashBegin(), '.');
+  for (size_t i = 0; i < directory_length; ++i)
+  {
+    if (directory[i] == '.')
+    {
+      return NULL;
+    }
+    hash = HashAppend(hash, directory[i] == '/' ? '.' : directory[i]);
+  }
+  if (needs_separator)
+  {
+    hash = HashAppend(hash, '.');
+  }
+  for (size_t i = 0; i < domain_name_length; ++i)
+  {
+    hash = HashAppend(hash, domain_name[i]);
+  }
+
+  const tEntry &entry = this->entries[Slot(hash, this->displacements[Bucket(hash, this->displacements.size() - 1)], this->mask)];
+  if (!entry.configuration || entry.hash != hash || entry.key_length != 1 + directory_length + needs_separator + domain_name_length)
+  {
+    return NULL;
+  }
+
+  const char *key = this->keys.data() + entry.key_offset + 1;
+  for (size_t i = 0; i < directory_length; ++i)
+  {
+    if (key[i] != (directory[i] == '/' ? '.' : directory[i]))
+    {
+      return NULL;
+    }
+  }
+  key += directory_length;
+  if (needs_separator && *key++ != '.')
+  {
+    return NULL;
+  }
+  if (domain_name_length && std::memcmp(key, domain_name, domain_name_length) != 0)
+  {
+    return NULL;
+  }
+
+  return entry.configuration;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,152 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/logging/configuration/tFrozenDomainTable.h
+ *
+ * \author  Tobias Föhst
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tFrozenDomainTable
+ *
+ * \b tFrozenDomainTable
+ *
+ * tFrozenDomainTable is a flat snapshot of the domain tree that maps
+ * full qualified domain names to their configurations. It uses a
+ * perfect hash function (hash and displace), so that each lookup
+ * probes exactly one slot of a contiguous table.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__logging__include_guard__
+#error Invalid include directive. Try #include "rrlib/logging/configuration.h" instead.
+#endif
+
+#ifndef __rrlib__logging__configuration__tFrozenDomainTable_h__
+#define __rrlib__logging__configuration__tFrozenDomainTable_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/logging/configuration/tConfiguration.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace logging
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! A flattened, immutable lookup table of the domain tree
+/*! Once the set of domains of a process does not change anymore, the
+ *  tree can be compiled into this table (see FreezeDomainRegistry).
+ *  The table stores one entry per configuration keyed by its full
+ *  qualified name. Source relative filenames are looked up by mapping
+ *  the directory separators to domain separators while hashing, so no
+ *  key has to be assembled at runtime.
+ *
+ *  Domains that are unknown to the table are not found and must be
+ *  looked up in the tree.
+ */
+class tFrozenDomainTable
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! The ctor of tFrozenDomainTable
+   *
+   * \param root   The root of the domain tree that should be compiled into the table
+   */
+  explicit tFrozenDomainTable(const tConfiguration &root);
+
+  /*! Find the configuration for a given filename and domain name
+   *
+   * The arguments are interpreted the same way as in
+   * tDomainRegistryImplementation::GetConfigurationBySourceRelativeFilename.
+   *
+   * \param filename      The source relative filename (may be zero for absolute domain names)
+   * \param domain_name   An optional explicitly specified domain name
+   *
+   * \returns The configuration or zero if the domain is not contained in the table
+   */
+  const tConfiguration *Find(const char *filename, const char *domain_name) const;
+
+  /*! Get the number of configurations in this table
+   *
+   * \returns The number of stored configurations
+   */
+  inline size_t Size() const
+  {
+    return this->size;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  struct tEntry
+  {
+    uint64_t hash;
+    uint32_t key_offset;
+    uint32_t key_length;
+    const tConfiguration *configuration;
+  };
+
+  size_t size;
+  uint64_t mask;
+  std::vector<uint64_t> displacements;
+  std::vector<tEntry> entries;
+  std::string keys;
+
+  bool Build(const std::vector<tEntry> &table_entries, size_t table_size);
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
@@ -167,6 +167,8 @@ int main(int argc, char **argv)
 
   RRLIB_LOG_PRINT(WARNING, "Warning message using std::iomanip: 0x", std::setw(20), std::setfill('0'), std::hex, 324);
 
+  RRLIB_LOG_FMT(WARNING, "Warning message using a checked format string: {:s} = 0x{:x}", "value", 324);
+
   RRLIB_LOG_PRINT(ERROR, "Multiline error message with\npadding and handling of trailing newline.\n");
   RRLIB_LOG_PRINT(USER, "Multiline user message\nthat should behave accordingly.\n");
 
@@ -64,39 +64,92 @@
 //----------------------------------------------------------------------
 // Macros for internal use
 //----------------------------------------------------------------------
-#define __RRLIB_LOG_PRINT__(domain, level, args...) \
+#ifdef RRLIB_LOGGING_SOURCE_ROOT
+#define __RRLIB_LOG_SOURCE_RELATIVE_FILE__ rrlib::logging::StripSourceRoot(__FILE__, RRLIB_LOGGING_SOURCE_ROOT)
+#else
+#define __RRLIB_LOG_SOURCE_RELATIVE_FILE__ 0
+#endif
+
+// Most messages are suppressed by their level. Thus, the code that prints them is moved out of the hot path
+#define __RRLIB_LOG_UNLIKELY__(condition) __builtin_expect(!!(condition), 0)
+
+#define __RRLIB_LOG_PRINT__(domain_name, level, args...) \
+  do \
+  { \
+    static rrlib::logging::tConfigurationHandle __rrlib_logging_configuration_handle__(__FILE__, domain_name, __RRLIB_LOG_SOURCE_RELATIVE_FILE__); \
+    const rrlib::logging::tConfiguration &__rrlib_logging_configuration__ = __rrlib_logging_configuration_handle__.Get(); \
+    if (__RRLIB_LOG_UNLIKELY__((level) <= __rrlib_logging_configuration__.MaxMessageLevel())) \
+    { \
+      static rrlib::logging::tCallSite __rrlib_logging_call_site__(__FUNCTION__, __FILE__, __LINE__); \
+      rrlib::logging::Print(__rrlib_logging_configuration__, GetLogDescription(), __rrlib_logging_call_site__, level, args); \
+    } \
+  } while(0) \
+     
+#define __RRLIB_LOG_PRINT_STATIC__(domain_name, level, args...) \
   do \
   { \
-    if ((level) <= domain.MaxMessageLevel()) \
+    static rrlib::logging::tConfigurationHandle __rrlib_logging_configuration_handle__(__FILE__, domain_name, __RRLIB_LOG_SOURCE_RELATIVE_FILE__); \
+    const rrlib::logging::tConfiguration &__rrlib_logging_configuration__ = __rrlib_logging_configuration_handle__.Get(); \
+    if (__RRLIB_LOG_UNLIKELY__((level) <= __rrlib_logging_configuration__.MaxMessageLevel())) \
     { \
-      rrlib::logging::Print(domain, GetLogDescription(), __FUNCTION__, __FILE__, __LINE__, level, args); \
+      static rrlib::logging::tCallSite __rrlib_logging_call_site__(__FUNCTION__, __FILE__, __LINE__, "<static>"); \
+      rrlib::logging::Print(__rrlib_logging_configuration__, "<static>", __rrlib_logging_call_site__, level, args); \
     } \
   } while(0) \
      
-#define __RRLIB_LOG_PRINT_STATIC__(domain, level, args...) \
+#define __RRLIB_LOG_PRINTF__(domain_name, level, args...) \
   do \
   { \
-    if ((level) <= domain.MaxMessageLevel()) \
+    static rrlib::logging::tConfigurationHandle __rrlib_logging_configuration_handle__(__FILE__, domain_name, __RRLIB_LOG_SOURCE_RELATIVE_FILE__); \
+    const rrlib::logging::tConfiguration &__rrlib_logging_configuration__ = __rrlib_logging_configuration_handle__.Get(); \
+    if (__RRLIB_LOG_UNLIKELY__((level) <= __rrlib_logging_configuration__.MaxMessageLevel())) \
     { \
-      rrlib::logging::Print(domain, "<static>", __FUNCTION__, __FILE__, __LINE__, level, args); \
+      static rrlib::logging::tCallSite __rrlib_logging_call_site__(__FUNCTION__, __FILE__, __LINE__); \
+      rrlib::logging::PrintFormatted(__rrlib_logging_configuration__, GetLogDescription(), __rrlib_logging_call_site__, level, args); \
     } \
   } while(0) \
      
-#define __RRLIB_LOG_PRINTF__(domain, level, args...) \
+#define __RRLIB_LOG_PRINTF_STATIC__(domain_name, level, args...) \
   do \
   { \
-    if ((level) <= domain.MaxMessageLevel()) \
+    static rrlib::logging::tConfigurationHandle __rrlib_logging_configuration_handle__(__FILE__, domain_name, __RRLIB_LOG_SOURCE_RELATIVE_FILE__); \
+    const rrlib::logging::tConfiguration &__rrlib_logging_configuration__ = __rrlib_logging_configuration_handle__.Get(); \
+    if (__RRLIB_LOG_UNLIKELY__((level) <= __rrlib_logging_configuration__.MaxMessageLevel())) \
     { \
-      rrlib::logging::PrintFormatted(domain, GetLogDescription(), __FUNCTION__, __FILE__, __LINE__, level, args); \
+      static rrlib::logging::tCallSite __rrlib_logging_call_site__(__FUNCTION__, __FILE__, __LINE__, "<static>"); \
+      rrlib::logging::PrintFormatted(__rrlib_logging_configuration__, "<static>", __rrlib_logging_call_site__, level, args); \
     } \
   } while(0) \
      
-#define __RRLIB_LOG_PRINTF_STATIC__(domain, level, args...) \
+#define __RRLIB_LOG_FMT__(domain_name, level, format, args...) \
   do \
   { \
-    if ((level) <= domain.MaxMessageLevel()) \
+    static rrlib::logging::tConfigurationHandle __rrlib_logging_configuration_handle__(__FILE__, domain_name, __RRLIB_LOG_SOURCE_RELATIVE_FILE__); \
+    const rrlib::logging::tConfiguration &__rrlib_logging_configuration__ = __rrlib_logging_configuration_handle__.Get(); \
+    if (__RRLIB_LOG_UNLIKELY__((level) <= __rrlib_logging_configuration__.MaxMessageLevel())) \
     { \
-      rrlib::logging::PrintFormatted(domain, "<static>", __FUNCTION__, __FILE__, __LINE__, level, args); \
+      static rrlib::logging::tCallSite __rrlib_logging_call_site__(__FUNCTION__, __FILE__, __LINE__); \
+      static constexpr rrlib::logging::tFormatLayout<rrlib::logging::CountFormatPieces(format)> __rrlib_logging_format_layout__(format); \
+      typedef decltype(rrlib::logging::FormatArgumentTypes(args)) __rrlib_logging_format_argument_types__; \
+      static_assert(rrlib::logging::CountFormatPlaceholders(__rrlib_logging_format_layout__) == __rrlib_logging_format_argument_types__::cSIZE, "The number of arguments does not match the number of placeholders in the format string"); \
+      static_assert(rrlib::logging::FormatArgumentsMatch(__rrlib_logging_format_layout__, __rrlib_logging_format_argument_types__()), "An argument does not match the conversion of its placeholder in the format string"); \
+      rrlib::logging::PrintFormatString(__rrlib_logging_configuration__, GetLogDescription(), __rrlib_logging_call_site__, level, format, __rrlib_logging_format_layout__, ##args); \
+    } \
+  } while(0) \
+     
+#define __RRLIB_LOG_FMT_STATIC__(domain_name, level, format, args...) \
+  do \
+  { \
+    static rrlib::logging::tConfigurationHandle __rrlib_logging_configuration_handle__(__FILE__, domain_name, __RRLIB_LOG_SOURCE_RELATIVE_FILE__); \
+    const rrlib::logging::tConfiguration &__rrlib_logging_configuration__ = __rrlib_logging_configuration_handle__.Get(); \
+    if (__RRLIB_LOG_UNLIKELY__((level) <= __rrlib_logging_configuration__.MaxMessageLevel())) \
+    { \
+      static rrlib::logging::tCallSite __rrlib_logging_call_site__(__FUNCTION__, __FILE__, __LINE__, "<static>"); \
+      static constexpr rrlib::logging::tFormatLayout<rrlib::logging::CountFormatPieces(format)> __rrlib_logging_format_layout__(format); \
+      typedef decltype(rrlib::logging::FormatArgumentTypes(args)) __rrlib_logging_format_argument_types__; \
+      static_assert(rrlib::logging::CountFormatPlaceholders(__rrlib_logging_format_layout__) == __rrlib_logging_format_argument_types__::cSIZE, "The number of arguments does not match the number of placeholders in the format string"); \
+      static_assert(rrlib::logging::FormatArgumentsMatch(__rrlib_logging_format_layout__, __rrlib_logging_format_argument_types__()), "An argument does not match the conversion of its placeholder in the format string"); \
+      rrlib::logging::PrintFormatString(__rrlib_logging_configuration__, "<static>", __rrlib_logging_call_site__, level, format, __rrlib_logging_format_layout__, ##args); \
     } \
   } while(0) \
      
@@ -117,7 +170,7 @@
   { \
     if ((__EXPAND_LEVEL__(level)) <= rrlib::logging::tLogLevel::DEBUG) \
     { \
-      __RRLIB_LOG_PRINT__(rrlib::logging::GetConfiguration(__FILE__), __EXPAND_LEVEL__(level), args); \
+      __RRLIB_LOG_PRINT__(0, __EXPAND_LEVEL__(level), args); \
     } \
   } while (0) \
      
@@ -132,7 +185,7 @@
   { \
     if ((__EXPAND_LEVEL__(level)) <= rrlib::logging::tLogLevel::DEBUG) \
     { \
-      __RRLIB_LOG_PRINT__(rrlib::logging::GetConfiguration(__FILE__, #domain), __EXPAND_LEVEL__(level), args); \
+      __RRLIB_LOG_PRINT__(#domain, __EXPAND_LEVEL__(level), args); \
     } \
   } while (0) \
      
@@ -146,7 +199,7 @@
   { \
     if ((__EXPAND_LEVEL__(level)) <= rrlib::logging::tLogLevel::DEBUG) \
     { \
-      __RRLIB_LOG_PRINT_STATIC__(rrlib::logging::GetConfiguration(__FILE__), __EXPAND_LEVEL__(level), args); \
+      __RRLIB_LOG_PRINT_STATIC__(0, __EXPAND_LEVEL__(level), args); \
     } \
   } while (0) \
      
@@ -161,7 +214,7 @@
   { \
     if ((__EXPAND_LEVEL__(level)) <= rrlib::logging::tLogLevel::DEBUG) \
     { \
-      __RRLIB_LOG_PRINT_STATIC__(rrlib::logging::GetConfiguration(__FILE__, #domain), __EXPAND_LEVEL__(level), args); \
+      __RRLIB_LOG_PRINT_STATIC__(#domain, __EXPAND_LEVEL__(level), args); \
     } \
   } while (0) \
      
@@ -175,7 +228,7 @@
   { \
     if ((__EXPAND_LEVEL__(level)) <= rrlib::logging::tLogLevel::DEBUG) \
     { \
-      __RRLIB_LOG_PRINTF__(rrlib::logging::GetConfiguration(__FILE__), __EXPAND_LEVEL__(level), args); \
+      __RRLIB_LOG_PRINTF__(0, __EXPAND_LEVEL__(level), args); \
     } \
   } while (0) \
      
@@ -190,7 +243,7 @@
   { \
     if ((__EXPAND_LEVEL__(level)) <= rrlib::logging::tLogLevel::DEBUG) \
     { \
-      __RRLIB_LOG_PRINTF__(rrlib::logging::GetConfiguration(__FILE__, #domain), __EXPAND_LEVEL__(level), args); \
+      __RRLIB_LOG_PRINTF__(#domain, __EXPAND_LEVEL__(level), args); \
     } \
   } while (0) \
      
@@ -204,7 +257,7 @@
   { \
     if ((__EXPAND_LEVEL__(level)) <= rrlib::logging::tLogLevel::DEBUG) \
     { \
-      __RRLIB_LOG_PRINTF_STATIC__(rrlib::logging::GetConfiguration(__FILE__), __EXPAND_LEVEL__(level), args); \
+      __RRLIB_LOG_PRINTF_STATIC__(0, __EXPAND_LEVEL__(level), args); \
     } \
   } while (0) \
      
@@ -219,7 +272,69 @@
   { \
     if ((__EXPAND_LEVEL__(level)) <= rrlib::logging::tLogLevel::DEBUG) \
     { \
-      __RRLIB_LOG_PRINTF_STATIC__(rrlib::logging::GetConfiguration(__FILE__, #domain), __EXPAND_LEVEL__(level), args); \
+      __RRLIB_LOG_PRINTF_STATIC__(#domain, __EXPAND_LEVEL__(level), args); \
+    } \
+  } while (0) \
+     
+/*! Macro to print messages using a compile time checked format string
+ *
+ * \param level    The level of the message
+ * \param format   The format string (a string literal, see messages/format_string.h)
+ * \param args     The arguments for the placeholders in the format string
+ */
+#define RRLIB_LOG_FMT(level, format, args...) \
+  do \
+  { \
+    if ((__EXPAND_LEVEL__(level)) <= rrlib::logging::tLogLevel::DEBUG) \
+    { \
+      __RRLIB_LOG_FMT__(0, __EXPAND_LEVEL__(level), format, ##args); \
+    } \
+  } while (0) \
+     
+/*! Macro to print messages to explicitly specified domain using a compile time checked format string
+ *
+ * \param domain   The domain the message should be printed to
+ * \param level    The level of the message
+ * \param format   The format string (a string literal, see messages/format_string.h)
+ * \param args     The arguments for the placeholders in the format string
+ */
+#define RRLIB_LOG_FMT_TO(domain, level, format, args...) \
+  do \
+  { \
+    if ((__EXPAND_LEVEL__(level)) <= rrlib::logging::tLogLevel::DEBUG) \
+    { \
+      __RRLIB_LOG_FMT__(#domain, __EXPAND_LEVEL__(level), format, ##args); \
+    } \
+  } while (0) \
+     
+/*! Macro to print messages using a compile time checked format string from static context
+ *
+ * \param level    The level of the message
+ * \param format   The format string (a string literal, see messages/format_string.h)
+ * \param args     The arguments for the placeholders in the format string
+ */
+#define RRLIB_LOG_FMT_STATIC(level, format, args...) \
+  do \
+  { \
+    if ((__EXPAND_LEVEL__(level)) <= rrlib::logging::tLogLevel::DEBUG) \
+    { \
+      __RRLIB_LOG_FMT_STATIC__(0, __EXPAND_LEVEL__(level), format, ##args); \
+    } \
+  } while (0) \
+     
+/*! Macro to print messages to explicitly specified domain using a compile time checked format string from static context
+ *
+ * \param domain   The domain the message should be printed to
+ * \param level    The level of the message
+ * \param format   The format string (a string literal, see messages/format_string.h)
+ * \param args     The arguments for the placeholders in the format string
+ */
+#define RRLIB_LOG_FMT_STATIC_TO(domain, level, format, args...) \
+  do \
+  { \
+    if ((__EXPAND_LEVEL__(level)) <= rrlib::logging::tLogLevel::DEBUG) \
+    { \
+      __RRLIB_LOG_FMT_STATIC__(#domain, __EXPAND_LEVEL__(level), format, ##args); \
     } \
   } while (0) \
      
@@ -231,7 +346,7 @@
  * \param args     The data to be put into the underlying stream
  */
 #define RRLIB_LOG_PRINT(level, args...) \
-  __RRLIB_LOG_PRINT__(rrlib::logging::GetConfiguration(__FILE__), __EXPAND_LEVEL__(level), args) \
+  __RRLIB_LOG_PRINT__(0, __EXPAND_LEVEL__(level), args) \
    
 /*! Macro to print messages to explicitly specified domain using stream semantics
  *
@@ -240,7 +355,7 @@
  * \param args     The data to be put into the underlying stream
  */
 #define RRLIB_LOG_PRINT_TO(domain, level, args...) \
-  __RRLIB_LOG_PRINT__(rrlib::logging::GetConfiguration(__FILE__, #domain), __EXPAND_LEVEL__(level), args) \
+  __RRLIB_LOG_PRINT__(#domain, __EXPAND_LEVEL__(level), args) \
    
 /*! Macro to print messages using stream semantics static context
  *
@@ -248,7 +363,7 @@
  * \param args     The data to be put into the underlying stream
  */
 #define RRLIB_LOG_PRINT_STATIC(level, args...) \
-  __RRLIB_LOG_PRINT_STATIC__(rrlib::logging::GetConfiguration(__FILE__), __EXPAND_LEVEL__(level), args) \
+  __RRLIB_LOG_PRINT_STATIC__(0, __EXPAND_LEVEL__(level), args) \
    
 /*! Macro to print messages to explicitly specified using stream semantics static context
  *
@@ -257,7 +372,7 @@
  * \param args     The data to be put into the underlying stream
  */
 #define RRLIB_LOG_PRINT_STATIC_TO(domain, level, args...) \
-  __RRLIB_LOG_PRINT_STATIC__(rrlib::logging::GetConfiguration(__FILE__, #domain), __EXPAND_LEVEL__(level), args) \
+  __RRLIB_LOG_PRINT_STATIC__(#domain, __EXPAND_LEVEL__(level), args) \
    
 /*! Macro to print messages using printf semantics
  *
@@ -265,7 +380,7 @@
  * \param args     The format string for printf and the optional arguments to be printed
  */
 #define RRLIB_LOG_PRINTF(level, args...) \
-  __RRLIB_LOG_PRINTF__(rrlib::logging::GetConfiguration(__FILE__), __EXPAND_LEVEL__(level), args) \
+  __RRLIB_LOG_PRINTF__(0, __EXPAND_LEVEL__(level), args) \
    
 /*! Macro to print messages to explicitly specified using printf semantics
  *
@@ -274,7 +389,7 @@
  * \param args     The format string for printf and the optional arguments to be printed
  */
 #define RRLIB_LOG_PRINTF_TO(domain, level, args...) \
-  __RRLIB_LOG_PRINTF__(rrlib::logging::GetConfiguration(__FILE__, #domain), __EXPAND_LEVEL__(level), args) \
+  __RRLIB_LOG_PRINTF__(#domain, __EXPAND_LEVEL__(level), args) \
    
 /*! Macro to print messages using printf semantics from static context
  *
@@ -282,7 +397,7 @@
  * \param args     The format string for printf and the optional arguments to be printed
  */
 #define RRLIB_LOG_PRINTF_STATIC(level, args...) \
-  __RRLIB_LOG_PRINTF_STATIC__(rrlib::logging::GetConfiguration(__FILE__), __EXPAND_LEVEL__(level), args) \
+  __RRLIB_LOG_PRINTF_STATIC__(0, __EXPAND_LEVEL__(level), args) \
    
 /*! Macro to print messages to explicitly specified using printf semantics from static context
  *
@@ -291,7 +406,45 @@
  * \param args     The format string for printf and the optional arguments to be printed
  */
 #define RRLIB_LOG_PRINTF_STATIC_TO(domain, level, args...) \
-  __RRLIB_LOG_PRINTF_STATIC__(rrlib::logging::GetConfiguration(__FILE__, #domain), __EXPAND_LEVEL__(level), args) \
+  __RRLIB_LOG_PRINTF_STATIC__(#domain, __EXPAND_LEVEL__(level), args) \
+   
+/*! Macro to print messages using a compile time checked format string
+ *
+ * \param level    The level of the message
+ * \param format   The format string (a string literal, see messages/format_string.h)
+ * \param args     The arguments for the placeholders in the format string
+ */
+#define RRLIB_LOG_FMT(level, format, args...) \
+  __RRLIB_LOG_FMT__(0, __EXPAND_LEVEL__(level), format, ##args) \
+   
+/*! Macro to print messages to explicitly specified domain using a compile time checked format string
+ *
+ * \param domain   The domain the message should be printed to
+ * \param level    The level of the message
+ * \param format   The format string (a string literal, see messages/format_string.h)
+ * \param args     The arguments for the placeholders in the format string
+ */
+#define RRLIB_LOG_FMT_TO(domain, level, format, args...) \
+  __RRLIB_LOG_FMT__(#domain, __EXPAND_LEVEL__(level), format, ##args) \
+   
+/*! Macro to print messages using a compile time checked format string from static context
+ *
+ * \param level    The level of the message
+ * \param format   The format string (a string literal, see messages/format_string.h)
+ * \param args     The arguments for the placeholders in the format string
+ */
+#define RRLIB_LOG_FMT_STATIC(level, format, args...) \
+  __RRLIB_LOG_FMT_STATIC__(0, __EXPAND_LEVEL__(level), format, ##args) \
+   
+/*! Macro to print messages to explicitly specified domain using a compile time checked format string from static context
+ *
+ * \param domain   The domain the message should be printed to
+ * \param level    The level of the message
+ * \param format   The format string (a string literal, see messages/format_string.h)
+ * \param args     The arguments for the placeholders in the format string
+ */
+#define RRLIB_LOG_FMT_STATIC_TO(domain, level, format, args...) \
+  __RRLIB_LOG_FMT_STATIC__(#domain, __EXPAND_LEVEL__(level), format, ##args) \
    
 #endif
 
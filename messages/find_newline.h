@@ -0,0 +1,120 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/logging/messages/find_newline.h
+ *
+ * \author  Tobias Föhst
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains FindNewline
+ *
+ * Multi-line padding needs the position of each newline in a message.
+ * Lines are typically short compared to the overhead of a call to
+ * memchr, so the search is inlined and uses SSE2 or AVX2 instructions
+ * if the target supports them. Otherwise, memchr is used.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__logging__include_guard__
+#error Invalid include directive. Try #include "rrlib/logging/messages.h" instead.
+#endif
+
+#ifndef __rrlib__logging__messages__find_newline_h__
+#define __rrlib__logging__messages__find_newline_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace logging
+{
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+/*! Find the first newline in a block of characters
+ *
+ * \param begin   The first character of the block
+ * \param end     The end of the block (exclusive)
+ *
+ * \returns A pointer to the first newline or zero if the block does not contain one
+ */
+inline const char *FindNewline(const char *begin, const char *end)
+{
+#if defined(__AVX2__)
+  const __m256i newlines = _mm256_set1_epi8('\n');
+  for (; end - begin >= 32; begin += 32)
+  {
+    const unsigned int mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin)), newlines));
+    if (mask)
+    {
+      return begin + __builtin_ctz(mask);
+    }
+  }
+#endif
+#if defined(__SSE2__)
+  const __m128i newlines_128 = _mm_set1_epi8('\n');
+  for (; end - begin >= 16; begin += 16)
+  {
+    const unsigned int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(begin)), newlines_128));
+    if (mask)
+    {
+      return begin + __builtin_ctz(mask);
+    }
+  }
+  for (; begin != end; ++begin)
+  {
+    if (*begin == '\n')
+    {
+      return begin;
+    }
+  }
+  return 0;
+#else
+  return static_cast<const char *>(std::memchr(begin, '\n', end - begin));
+#endif
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
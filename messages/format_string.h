@@ -0,0 +1,368 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/logging/messages/format_string.h
+ *
+ * \author  Tobias Föhst
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains the compile time processing of format strings for RRLIB_LOG_FMT
+ *
+ * Format strings consist of plain text and placeholders. A placeholder
+ * is either {} for any streamable argument or {:c} with one of the
+ * following conversions:
+ *
+ *   d       integer in decimal notation
+ *   x, X    integer in hexadecimal notation (lower or upper case)
+ *   f       floating point value in fixed notation
+ *   e       floating point value in scientific notation
+ *   s       string (const char * or std::string)
+ *
+ * Literal braces are written as {{ and }}.
+ *
+ * The format string is split into pieces of text that are followed by
+ * an optional placeholder at compile time. Thus, at runtime only the
+ * text pieces and arguments are written to the stream.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__logging__include_guard__
+#error Invalid include directive. Try #include "rrlib/logging/messages.h" instead.
+#endif
+
+#ifndef __rrlib__logging__messages__format_string_h__
+#define __rrlib__logging__messages__format_string_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstddef>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages/tStream.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace logging
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//! One piece of a format string: some text that is followed by an optional placeholder
+struct tFormatPiece
+{
+  size_t text_begin;
+  size_t text_length;
+  bool has_argument;
+  char conversion;
+};
+
+//! The types of the arguments given for a format string
+template <typename ... TArgs>
+struct tFormatArgumentTypes
+{
+  static const size_t cSIZE = sizeof...(TArgs);
+};
+
+template <size_t ... Indices>
+struct tFormatIndices
+{};
+
+template <size_t N, size_t ... Indices>
+struct tMakeFormatIndices : tMakeFormatIndices < N - 1, N - 1, Indices... >
+{};
+
+template <size_t ... Indices>
+struct tMakeFormatIndices<0, Indices...>
+{
+  typedef tFormatIndices<Indices...> tType;
+};
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+namespace format_string
+{
+
+constexpr bool IsBrace(char c)
+{
+  return c == '{' || c == '}';
+}
+
+constexpr bool IsConversion(char c)
+{
+  return c == 'd' || c == 'x' || c == 'X' || c == 'f' || c == 'e' || c == 's';
+}
+
+constexpr size_t PickFirst(size_t left, size_t middle, size_t right)
+{
+  return left != middle ? left : right;
+}
+
+// Divide and conquer keeps the recursion depth logarithmic in the length of the format string
+template <size_t N>
+constexpr size_t FindBrace(const char (&format)[N], size_t begin, size_t end)
+{
+  return end - begin <= 1 ? ((begin < end && IsBrace(format[begin])) ? begin : end) :
+         PickFirst(FindBrace(format, begin, begin + (end - begin) / 2), begin + (end - begin) / 2, FindBrace(format, begin + (end - begin) / 2, end));
+}
+
+template <size_t N>
+constexpr size_t TextEnd(const char (&format)[N], size_t begin)
+{
+  return FindBrace(format, begin, N - 1);
+}
+
+template <size_t N>
+constexpr bool IsEscapedBrace(const char (&format)[N], size_t position)
+{
+  return position < N - 1 && format[position] == format[position + 1];
+}
+
+template <size_t N>
+constexpr bool IsPlainPlaceholder(const char (&format)[N], size_t position)
+{
+  return position < N - 1 && format[position] == '{' && format[position + 1] == '}';
+}
+
+template <size_t N>
+constexpr bool IsConversionPlaceholder(const char (&format)[N], size_t position)
+{
+  return position < N - 1 && format[position] == '{' && format[position + 1] == ':' && IsConversion(format[position + 2]) && format[position + 3] == '}';
+}
+
+template <size_t N>
+constexpr size_t NextPieceBeginAt(const char (&format)[N], size_t end)
+{
+  return end == N - 1 ? N :
+         IsEscapedBrace(format, end) || IsPlainPlaceholder(format, end) ? end + 2 :
+         IsConversionPlaceholder(format, end) ? end + 4 :
+         throw std::invalid_argument("Invalid placeholder or unescaped brace in format string");
+}
+
+template <size_t N>
+constexpr size_t PieceBegin(const char (&format)[N], size_t index)
+{
+  return index == 0 ? 0 : NextPieceBeginAt(format, TextEnd(format, PieceBegin(format, index - 1)));
+}
+
+template <size_t N>
+constexpr size_t CountPiecesFrom(const char (&format)[N], size_t begin)
+{
+  return begin >= N ? 0 : 1 + CountPiecesFrom(format, NextPieceBeginAt(format, TextEnd(format, begin)));
+}
+
+template <size_t N>
+constexpr tFormatPiece MakePieceAt(const char (&format)[N], size_t begin, size_t end)
+{
+  return tFormatPiece
+  {
+    begin,
+    end - begin + (IsEscapedBrace(format, end) ? 1 : 0),
+    IsPlainPlaceholder(format, end) || IsConversionPlaceholder(format, end),
+    IsConversionPlaceholder(format, end) ? format[end + 2] : '\0'
+  };
+}
+
+template <size_t N>
+constexpr tFormatPiece MakePiece(const char (&format)[N], size_t index)
+{
+  return MakePieceAt(format, PieceBegin(format, index), TextEnd(format, PieceBegin(format, index)));
+}
+
+template <typename T>
+struct tIsString
+{
+  typedef typename std::decay<T>::type tDecayed;
+  static const bool cVALUE = std::is_same<tDecayed, const char *>::value || std::is_same<tDecayed, char *>::value || std::is_same<tDecayed, std::string>::value;
+};
+
+// Integral arguments of numeric conversions are promoted, so that characters are printed as numbers
+template <typename T>
+inline auto PromoteInteger(const T &value, std::true_type) -> decltype(+value)
+{
+  return +value;
+}
+
+template <typename T>
+inline const T &PromoteInteger(const T &value, std::false_type)
+{
+  return value;
+}
+
+template <typename T>
+inline auto PromoteInteger(const T &value) -> decltype(PromoteInteger(value, std::is_integral<T>()))
+{
+  return PromoteInteger(value, std::is_integral<T>());
+}
+
+template <typename T>
+constexpr bool AcceptsConversion(char conversion)
+{
+  return conversion == '\0' ||
+         ((conversion == 'd' || conversion == 'x' || conversion == 'X') && std::is_integral<T>::value && !std::is_same<T, bool>::value) ||
+         ((conversion == 'f' || conversion == 'e') && std::is_floating_point<T>::value) ||
+         (conversion == 's' && tIsString<T>::cVALUE);
+}
+
+}
+
+//! The pieces of a format string, computed at compile time
+template <size_t Tsize>
+struct tFormatLayout
+{
+  tFormatPiece pieces[Tsize];
+
+  template <size_t N>
+  constexpr tFormatLayout(const char (&format)[N])
+    : tFormatLayout(format, typename tMakeFormatIndices<Tsize>::tType())
+  {}
+
+  template <size_t N, size_t ... Indices>
+  constexpr tFormatLayout(const char (&format)[N], tFormatIndices<Indices...>)
+    : pieces { format_string::MakePiece(format, Indices)... }
+  {}
+};
+
+/*! Count the pieces a format string consists of
+ *
+ * \param format   The format string
+ *
+ * \returns The number of pieces (at least one)
+ */
+template <size_t N>
+constexpr size_t CountFormatPieces(const char (&format)[N])
+{
+  return format_string::CountPiecesFrom(format, 0);
+}
+
+/*! Count the placeholders of a format string layout
+ *
+ * \param layout   The layout of the format string
+ * \param index    The index of the first piece to consider
+ *
+ * \returns The number of placeholders
+ */
+template <size_t Tsize>
+constexpr size_t CountFormatPlaceholders(const tFormatLayout<Tsize> &layout, size_t index = 0)
+{
+  return index == Tsize ? 0 : (layout.pieces[index].has_argument ? 1 : 0) + CountFormatPlaceholders(layout, index + 1);
+}
+
+template <typename ... TArgs>
+tFormatArgumentTypes<TArgs...> FormatArgumentTypes(const TArgs &...);
+
+/*! Check whether the types of the arguments fit to the conversions of the placeholders
+ *
+ * \param layout   The layout of the format string
+ * \param index    The index of the first piece to consider
+ *
+ * \returns Whether all arguments match their placeholders
+ */
+template <size_t Tsize>
+constexpr bool FormatArgumentsMatch(const tFormatLayout<Tsize> &, tFormatArgumentTypes<>, size_t = 0)
+{
+  return true;
+}
+
+template <size_t Tsize, typename THead, typename ... TTail>
+constexpr bool FormatArgumentsMatch(const tFormatLayout<Tsize> &layout, tFormatArgumentTypes<THead, TTail...>, size_t index = 0)
+{
+  return index < Tsize &&
+         (layout.pieces[index].has_argument ?
+          format_string::AcceptsConversion<THead>(layout.pieces[index].conversion) && FormatArgumentsMatch(layout, tFormatArgumentTypes<TTail...>(), index + 1) :
+          FormatArgumentsMatch(layout, tFormatArgumentTypes<THead, TTail...>(), index + 1));
+}
+
+template <typename T>
+void SendFormatArgumentToStream(tStream &stream, char conversion, const T &value)
+{
+  switch (conversion)
+  {
+  case 'd':
+    stream << format_string::PromoteInteger(value);
+    break;
+  case 'x':
+    stream << std::hex << format_string::PromoteInteger(value) << std::dec;
+    break;
+  case 'X':
+    stream << std::hex << std::uppercase << format_string::PromoteInteger(value) << std::nouppercase << std::dec;
+    break;
+  case 'f':
+    stream << std::fixed << value << std::resetiosflags(std::ios_base::floatfield);
+    break;
+  case 'e':
+    stream << std::scientific << value << std::resetiosflags(std::ios_base::floatfield);
+    break;
+  default:
+    stream << value;
+  }
+}
+
+/*! Send a message given by format string and arguments to a stream
+ *
+ * \param stream   The stream to send the message to
+ * \param format   The format string
+ * \param layout   The layout of the format string
+ * \param index    The index of the piece to continue with
+ * \param args     The remaining arguments
+ */
+template <size_t Tsize>
+void SendFormatStringToStream(tStream &stream, const char *format, const tFormatLayout<Tsize> &layout, size_t index)
+{
+  for (; index < Tsize; ++index)
+  {
+    stream.Buffer().sputn(format + layout.pieces[index].text_begin, layout.pieces[index].text_length);
+  }
+}
+
+template <size_t Tsize, typename THead, typename ... TTail>
+void SendFormatStringToStream(tStream &stream, const char *format, const tFormatLayout<Tsize> &layout, size_t index, const THead &head, const TTail &... tail)
+{
+  for (; !layout.pieces[index].has_argument; ++index)
+  {
+    stream.Buffer().sputn(format + layout.pieces[index].text_begin, layout.pieces[index].text_length);
+  }
+  stream.Buffer().sputn(format + layout.pieces[index].text_begin, layout.pieces[index].text_length);
+  SendFormatArgumentToStream(stream, layout.pieces[index].conversion, head);
+  SendFormatStringToStream(stream, format, layout, index + 1, tail...);
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
@@ -33,13 +33,15 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
-#include <cstdio>
 #include <ctime>
+#include <type_traits>
+#include <vector>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
 #include "rrlib/logging/configuration/tDomainRegistry.h"
+#include "rrlib/logging/messages/tLocalTimeCache.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -64,6 +66,31 @@ namespace logging
 //----------------------------------------------------------------------
 // Const values
 //----------------------------------------------------------------------
+const size_t cLEVEL_COLUMN_WIDTH = 9;
+
+//! How the prefix of messages with a certain level is formatted
+struct tLevelFormat
+{
+  bool colored;
+  tFormattingBufferEffect effect;
+  tFormattingBufferColor color;
+  const char *padded_label;
+  size_t label_length;
+};
+
+//! The formats indexed by tLogLevel. Labels are padded to the level column
+constexpr tLevelFormat cLEVEL_FORMATS[] =
+{
+  { false, eSBE_REGULAR, eSBC_DEFAULT, "         ", 0 }, // USER
+  { true, eSBE_BOLD, eSBC_RED, "[error]  ", 7 }, // ERROR
+  { true, eSBE_BOLD, eSBC_BLUE, "[warning]", 9 }, // WARNING
+  { true, eSBE_DARK, eSBC_YELLOW, "[debug]  ", 7 }, // DEBUG_WARNING
+  { true, eSBE_DARK, eSBC_GREEN, "[debug]  ", 7 }, // DEBUG
+  { true, eSBE_REGULAR, eSBC_CYAN, "[verbose]", 9 }, // DEBUG_VERBOSE_1
+  { true, eSBE_REGULAR, eSBC_CYAN, "[verbose]", 9 }, // DEBUG_VERBOSE_2
+  { true, eSBE_REGULAR, eSBC_CYAN, "[verbose]", 9 } // DEBUG_VERBOSE_3
+};
+static_assert(sizeof(cLEVEL_FORMATS) / sizeof(cLEVEL_FORMATS[0]) == static_cast<size_t>(tLogLevel::DIMENSION), "There must be a format for each log level");
 
 //----------------------------------------------------------------------
 // Implementation
@@ -77,111 +104,152 @@ const tConfiguration &GetConfiguration(const char *filename, const char *domain_
   return tDomainRegistry::Instance().GetConfiguration(default_context, filename, domain_name);
 }
 
-//----------------------------------------------------------------------
-// SendFormattedTimeToStream
-//----------------------------------------------------------------------
+namespace
+{
+
+#if __linux__
+
+//! The time prefix of the current second, rendered once per thread
+struct tTimePrefixCache
+{
+  time_t second;
+  tLocalTimeCache local_time_cache;
+  char prefix[22];
+
+  tTimePrefixCache() : second(-1), prefix {'[', ' ', '0', '0', ':', '0', '0', ':', '0', '0', '.', '0', '0', '0', '0', '0', '0', '0', '0', '0', ' ', ']'} {}
+};
+
+// Without destructor, the cache stays usable for messages from destructors of other thread_local or static objects
+static_assert(std::is_trivially_destructible<tTimePrefixCache>::value, "The time prefix cache must survive the destruction of thread_local objects");
+thread_local tTimePrefixCache time_prefix_cache;
+
+void UpdateTimePrefix(tTimePrefixCache &cache, time_t second)
+{
+  const bool minute_changed = cache.local_time_cache.Update(second);
+  const tm &local_time = cache.local_time_cache.LocalTime();
+  if (minute_changed)
+  {
+    FormatDigits(cache.prefix + 2, local_time.tm_hour, 2);
+    FormatDigits(cache.prefix + 5, local_time.tm_min, 2);
+  }
+  FormatDigits(cache.prefix + 8, local_time.tm_sec, 2);
+  cache.second = second;
+}
+#endif
+
 void SendFormattedTimeToStream(tStream &stream)
 {
 #if __linux__
-  char time_string_buffer[9];
   timespec time;
   clock_gettime(CLOCK_REALTIME, &time);
-  strftime(time_string_buffer, sizeof(time_string_buffer), "%T", localtime(&time.tv_sec));
-  char nsec_string_buffer[11];
-  snprintf(nsec_string_buffer, sizeof(nsec_string_buffer), ".%09ld", time.tv_nsec);
-  stream << "[ " << time_string_buffer << nsec_string_buffer << " ] ";
+  tTimePrefixCache &cache = time_prefix_cache;
+  if (time.tv_sec != cache.second)
+  {
+    UpdateTimePrefix(cache, time.tv_sec);
+  }
+
+  FormatDigits(cache.prefix + 11, time.tv_nsec, 9);
+  stream.Buffer().sputn(cache.prefix, sizeof(cache.prefix));
 #endif
 }
 
-//----------------------------------------------------------------------
-// SetColor
-//----------------------------------------------------------------------
 void SetColor(tFormattingBuffer &stream_buffer, tLogLevel level)
 {
-  switch (level)
+  const tLevelFormat &level_format = cLEVEL_FORMATS[static_cast<size_t>(level)];
+  if (level_format.colored)
   {
-  case tLogLevel::ERROR:
-    stream_buffer.SetColor(eSBE_BOLD, eSBC_RED);
-    break;
-  case tLogLevel::WARNING:
-    stream_buffer.SetColor(eSBE_BOLD, eSBC_BLUE);
-    break;
-  case tLogLevel::DEBUG_WARNING:
-    stream_buffer.SetColor(eSBE_DARK, eSBC_YELLOW);
-    break;
-  case tLogLevel::DEBUG:
-    stream_buffer.SetColor(eSBE_DARK, eSBC_GREEN);
-    break;
-  case tLogLevel::DEBUG_VERBOSE_1:
-    stream_buffer.SetColor(eSBE_REGULAR, eSBC_CYAN);
-    break;
-  case tLogLevel::DEBUG_VERBOSE_2:
-    stream_buffer.SetColor(eSBE_REGULAR, eSBC_CYAN);
-    break;
-  case tLogLevel::DEBUG_VERBOSE_3:
-    stream_buffer.SetColor(eSBE_REGULAR, eSBC_CYAN);
-    break;
-  default:
-    ;
+    stream_buffer.SetColor(level_format.effect, level_format.color);
   }
 }
 
-//----------------------------------------------------------------------
-// SendFormattedDomainNameToStream
-//----------------------------------------------------------------------
-void SendFormattedDomainNameToStream(tStream &stream, const std::string &domain_name)
+void SendFormattedDomainNameToStream(tStream &stream, const tConfiguration &domain_configuration)
 {
-  char name_string_buffer[128];
-  snprintf(name_string_buffer, sizeof(name_string_buffer), "%-*s ", static_cast<int>((tDomainRegistry::Instance().GetPadPrefixColumns() ? tDomainRegistry::Instance().MaxDomainNameLength() : 0)), domain_name.c_str());
-  stream << name_string_buffer;
+  if (tDomainRegistry::Instance().GetPadPrefixColumns())
+  {
+    // The padded name includes a separating space that is part of the template
+    const std::string &padded_name = domain_configuration.GetPaddedFullQualifiedName(tDomainRegistry::Instance().MaxDomainNameLength());
+    stream.Buffer().sputn(padded_name.data(), padded_name.length() - 1);
+    return;
+  }
+  const std::string &name = domain_configuration.GetFullQualifiedName();
+  stream.Buffer().sputn(name.data(), name.length());
 }
 
-//----------------------------------------------------------------------
-// SendFormattedLevelToStream
-//----------------------------------------------------------------------
 void SendFormattedLevelToStream(tStream &stream, tLogLevel level)
 {
-  const char *level_name = 0;
-  switch (level)
-  {
-  case tLogLevel::ERROR:
-    level_name = "[error]";
-    break;
-  case tLogLevel::WARNING:
-    level_name = "[warning]";
-    break;
-  case tLogLevel::DEBUG_WARNING:
-    level_name = "[debug]";
-    break;
-  case tLogLevel::DEBUG:
-    level_name = "[debug]";
-    break;
-  case tLogLevel::DEBUG_VERBOSE_1:
-    level_name = "[verbose]";
-    break;
-  case tLogLevel::DEBUG_VERBOSE_2:
-    level_name = "[verbose]";
-    break;
-  case tLogLevel::DEBUG_VERBOSE_3:
-    level_name = "[verbose]";
-    break;
-  default:
-    level_name = "";
-    break;
-  }
-  char name_string_buffer[128];
-  snprintf(name_string_buffer, sizeof(name_string_buffer), "%-*s ", (tDomainRegistry::Instance().GetPadPrefixColumns() ? 9 : 0), level_name);
-  stream << name_string_buffer;
+  const tLevelFormat &level_format = cLEVEL_FORMATS[static_cast<size_t>(level)];
+  stream.Buffer().sputn(level_format.padded_label, tDomainRegistry::Instance().GetPadPrefixColumns() ? cLEVEL_COLUMN_WIDTH : level_format.label_length);
+}
+
 }
 
 //----------------------------------------------------------------------
-// SendFormattedLocationToStream
+// SendPrefixToStream
 //----------------------------------------------------------------------
-void SendFormattedLocationToStream(tStream &stream, const char *filename, unsigned int line)
+void SendPrefixToStream(tStream &stream, const tConfiguration &domain_configuration, tCallSite &call_site, tLogLevel level,
+                        void (*send_log_description)(tStream &, const void *), const void *log_description, bool less_output)
 {
-  char location_string_buffer[128];
-  snprintf(location_string_buffer, sizeof(location_string_buffer), "[%s:%u] ", filename, line);
-  stream << location_string_buffer;
+  tRecordBuffer &stream_buffer = stream.Buffer();
+  stream_buffer.InitializeMultiLinePadding();
+
+  if (level != tLogLevel::USER)
+  {
+    const tPrefixTemplate &prefix_template = less_output ? tPrefixTemplate::Default(domain_configuration.PrintsTime(), false, false, false) : domain_configuration.PrefixTemplate();
+    const std::string *call_site_texts = call_site.Texts(prefix_template);
+    const std::vector<tPrefixTemplate::tOperation> &operations = prefix_template.Operations();
+    for (auto it = operations.begin(); it != operations.end(); ++it)
+    {
+      switch (it->type)
+      {
+      case tPrefixTemplate::tOperationType::TEXT:
+        stream_buffer.sputn(prefix_template.Text() + it->offset, it->length);
+        break;
+      case tPrefixTemplate::tOperationType::CALL_SITE_TEXT:
+        stream_buffer.sputn(call_site_texts[it->offset].data(), call_site_texts[it->offset].length());
+        break;
+      case tPrefixTemplate::tOperationType::TIME:
+        SendFormattedTimeToStream(stream);
+        break;
+      case tPrefixTemplate::tOperationType::COLOR:
+        SetColor(stream_buffer, level);
+        break;
+      case tPrefixTemplate::tOperationType::NAME:
+        SendFormattedDomainNameToStream(stream, domain_configuration);
+        break;
+      case tPrefixTemplate::tOperationType::LEVEL:
+        SendFormattedLevelToStream(stream, level);
+        break;
+      case tPrefixTemplate::tOperationType::DESCRIPTION:
+        if (call_site.StaticDescription())
+        {
+          stream_buffer.sputn(call_site.StaticDescription(), call_site.StaticDescriptionLength());
+        }
+        else
+        {
+          send_log_description(stream, log_description);
+        }
+        break;
+      case tPrefixTemplate::tOperationType::RESET_COLOR:
+        stream_buffer.ResetColor();
+        break;
+      }
+    }
+
+    switch (level)
+    {
+    case tLogLevel::ERROR:
+      stream_buffer.sputn("ERROR: ", 7);
+      break;
+    case tLogLevel::WARNING:
+    case tLogLevel::DEBUG_WARNING:
+      stream_buffer.sputn("WARNING: ", 9);
+      break;
+    default:
+      ;
+    }
+  }
+
+  stream_buffer.MarkEndOfPrefixForMultiLinePadding();
 }
 
 //----------------------------------------------------------------------
@@ -48,7 +48,10 @@
 //----------------------------------------------------------------------
 #include "rrlib/logging/log_levels.h"
 #include "rrlib/logging/configuration/tConfiguration.h"
+#include "rrlib/logging/configuration/tConfigurationHandle.h"
+#include "rrlib/logging/messages/tCallSite.h"
 #include "rrlib/logging/messages/tStream.h"
+#include "rrlib/logging/messages/format_string.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -64,16 +67,39 @@ namespace logging
 
 const tConfiguration &GetConfiguration(const char *filename, const char *domain_name = 0, const tDefaultConfigurationContext &default_context = cDEFAULT_CONTEXT);
 
-void SendFormattedTimeToStream(tStream &stream);
-void SendFormattedDomainNameToStream(tStream &stream, const std::string &domain_name);
-void SetColor(tFormattingBuffer &stream_buffer, tLogLevel level);
-void SendFormattedLevelToStream(tStream &stream, tLogLevel level);
-void SendFormattedLocationToStream(tStream &stream, const char *filename, unsigned int line);
+/*! Send the prefix of a message to a stream
+ *
+ * This function is shared by all instantiations of the print functions
+ * and kept out of line, as only the streaming of the message data
+ * depends on the argument types.
+ *
+ * \param stream                 The stream of the message
+ * \param domain_configuration   The configuration of the domain the message is sent to
+ * \param call_site              The call site of the message
+ * \param level                  The level of the message
+ * \param send_log_description   A function that sends the log description to the stream
+ * \param log_description        The log description (unless the call site has a static one)
+ * \param less_output            Whether the caller was compiled with RRLIB_LOGGING_LESS_OUTPUT
+ */
+void SendPrefixToStream(tStream &stream, const tConfiguration &domain_configuration, tCallSite &call_site, tLogLevel level,
+                        void (*send_log_description)(tStream &, const void *), const void *log_description, bool less_output) __attribute__((cold, noinline));
 
 
 
 namespace
 {
+#ifdef RRLIB_LOGGING_LESS_OUTPUT
+const bool cLESS_OUTPUT = true;
+#else
+const bool cLESS_OUTPUT = false;
+#endif
+
+template <typename TLogDescription>
+void SendLogDescriptionToStream(tStream &stream, const void *log_description)
+{
+  stream << *static_cast<const TLogDescription *>(log_description);
+}
+
 template <typename THead>
 void SendDataToStream(tStream &stream, const THead &head)
 {
@@ -91,94 +117,49 @@ void SendDataToStream(tStream &stream, const THead &head, const TTail &... tail)
 
 
 template <typename TLogDescription, typename ... TArgs>
-void Print(const tConfiguration &domain_configuration, const TLogDescription &log_description, const char *function, const char *filename, unsigned int line, tLogLevel level, const TArgs &... args)
+void Print(const tConfiguration &domain_configuration, const TLogDescription &log_description, tCallSite &call_site, tLogLevel level, const TArgs &... args)
 {
   if (level > domain_configuration.MaxMessageLevel())
   {
     return;
   }
 
-  tStream stream(&domain_configuration.StreamBuffer());
-  domain_configuration.StreamBuffer().InitializeMultiLinePadding();
+  tStream stream(domain_configuration.StreamBuffer());
+  SendPrefixToStream(stream, domain_configuration, call_site, level, &SendLogDescriptionToStream<TLogDescription>, &log_description, cLESS_OUTPUT);
+  SendDataToStream(stream, args...);
+}
 
-  if (level != tLogLevel::USER)
+template <typename TLogDescription, size_t Tsize, typename ... TArgs>
+void PrintFormatString(const tConfiguration &domain_configuration, const TLogDescription &log_description, tCallSite &call_site, tLogLevel level, const char *format, const tFormatLayout<Tsize> &layout, const TArgs &... args)
+{
+  if (level > domain_configuration.MaxMessageLevel())
   {
-
-    if (domain_configuration.PrintsTime())
-    {
-      SendFormattedTimeToStream(stream);
-    }
-
-    SetColor(domain_configuration.StreamBuffer(), level);
-
-#ifndef RRLIB_LOGGING_LESS_OUTPUT
-    if (domain_configuration.PrintsName())
-    {
-      SendFormattedDomainNameToStream(stream, domain_configuration.GetFullQualifiedName());
-    }
-    if (domain_configuration.PrintsLevel())
-    {
-      SendFormattedLevelToStream(stream, level);
-    }
-#endif
-
-    stream << log_description << "::" << function << " ";
-
-#ifndef RRLIB_LOGGING_LESS_OUTPUT
-    if (domain_configuration.PrintsLocation())
-    {
-      SendFormattedLocationToStream(stream, filename, line);
-    }
-#endif
-
-    stream << ">> ";
-
-    domain_configuration.StreamBuffer().ResetColor();
-
-    switch (level)
-    {
-    case tLogLevel::ERROR:
-      stream << "ERROR: ";
-      break;
-    case tLogLevel::WARNING:
-    case tLogLevel::DEBUG_WARNING:
-      stream << "WARNING: ";
-      break;
-    default:
-      ;
-    }
-
+    return;
   }
 
-  domain_configuration.StreamBuffer().MarkEndOfPrefixForMultiLinePadding();
-
-  SendDataToStream(stream, args...);
+  tStream stream(domain_configuration.StreamBuffer());
+  SendPrefixToStream(stream, domain_configuration, call_site, level, &SendLogDescriptionToStream<TLogDescription>, &log_description, cLESS_OUTPUT);
+  SendFormatStringToStream(stream, format, layout, 0, args...);
 }
 
 template <typename TLogDescription>
-void PrintFormatted(const tConfiguration &domain_configuration, const TLogDescription &log_description, const char *function, const char *filename, unsigned int line, tLogLevel level, const char *fmt, ...) __attribute__((format(printf, 7, 8)));
+void PrintFormatted(const tConfiguration &domain_configuration, const TLogDescription &log_description, tCallSite &call_site, tLogLevel level, const char *fmt, ...) __attribute__((format(printf, 5, 6)));
 
 template <typename TLogDescription>
-void PrintFormatted(const tConfiguration &domain_configuration, const TLogDescription &log_description, const char *function, const char *filename, unsigned int line, tLogLevel level, const char *fmt, ...)
+void PrintFormatted(const tConfiguration &domain_configuration, const TLogDescription &log_description, tCallSite &call_site, tLogLevel level, const char *fmt, ...)
 {
   if (level > domain_configuration.MaxMessageLevel())
   {
     return;
   }
 
-  va_list printf_args0;
-  va_start(printf_args0, fmt);
-  char temp;
-  int needed_buffer_size = vsnprintf(&temp, 1, fmt, printf_args0);
-  va_end(printf_args0);
-
-  va_list printf_args1;
-  va_start(printf_args1, fmt);
-  char buffer[needed_buffer_size + 1];
-  vsnprintf(buffer, sizeof(buffer), fmt, printf_args1);
-  va_end(printf_args1);
+  tStream stream(domain_configuration.StreamBuffer());
+  SendPrefixToStream(stream, domain_configuration, call_site, level, &SendLogDescriptionToStream<TLogDescription>, &log_description, cLESS_OUTPUT);
 
-  Print(domain_configuration, log_description, function, filename, line, level, static_cast<const char *>(buffer));
+  va_list printf_args;
+  va_start(printf_args, fmt);
+  stream.Buffer().AppendFormatted(fmt, printf_args);
+  va_end(printf_args);
 }
 
 //----------------------------------------------------------------------
@@ -0,0 +1,110 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/logging/messages/tCallSite.cpp
+ *
+ * \author  Tobias Föhst
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#define __rrlib__logging__include_guard__
+#include "rrlib/logging/messages/tCallSite.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <mutex>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace logging
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+namespace
+{
+std::mutex texts_mutex;
+}
+
+//----------------------------------------------------------------------
+// tCallSite PrepareTexts
+//----------------------------------------------------------------------
+const tCallSite::tTexts *tCallSite::PrepareTexts(const tPrefixTemplate &prefix_template)
+{
+  std::lock_guard<std::mutex> lock(texts_mutex);
+
+  // Call sites live until the end of the program and switching between templates is rare.
+  // Thus, texts are never deleted once published and reused when a former template is used again
+  const tTexts *texts = this->all_texts;
+  while (texts && texts->prefix_template_id != prefix_template.Id())
+  {
+    texts = texts->next;
+  }
+  if (!texts)
+  {
+    tTexts *new_texts = new tTexts();
+    new_texts->prefix_template_id = prefix_template.Id();
+    for (size_t i = 0; i < prefix_template.NumberOfCallSiteTexts(); ++i)
+    {
+      new_texts->texts.push_back(prefix_template.RenderCallSiteText(i, this->function, this->filename, this->line));
+    }
+    new_texts->next = this->all_texts;
+    this->all_texts = new_texts;
+    texts = new_texts;
+  }
+
+  this->texts.store(texts, std::memory_order_release);
+  return texts;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
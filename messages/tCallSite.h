@@ -0,0 +1,191 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/logging/messages/tCallSite.h
+ *
+ * \author  Tobias Föhst
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tCallSite
+ *
+ * \b tCallSite
+ *
+ * tCallSite describes one call site of the logging macros: function,
+ * file and line. The parts of the message prefix that only depend on
+ * these constants are built once on first use and copied into each
+ * following message.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__logging__include_guard__
+#error Invalid include directive. Try #include "rrlib/logging/messages.h" instead.
+#endif
+
+#ifndef __rrlib__logging__messages__tCallSite_h__
+#define __rrlib__logging__messages__tCallSite_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages/tPrefixTemplate.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace logging
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+namespace internal
+{
+constexpr size_t StringLength(const char *text)
+{
+  return *text ? 1 + StringLength(text + 1) : 0;
+}
+}
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! The constant data of one call site of the logging macros
+/*! Function, file and line of a call site are known at compile time.
+ *  Hence, a function local static instance of this class renders the
+ *  texts of a prefix template that only depend on these values once
+ *  (see tPrefixTemplate) and keeps them for all following messages.
+ *
+ *  Messages from static context use a fixed description, which is also
+ *  stored here together with its length.
+ *
+ *  The constructor is constexpr, so that static instances are
+ *  initialized at compile time without a guard variable.
+ */
+class tCallSite
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! The ctor of tCallSite
+   *
+   * \param function             The function the call site is located in (typically __FUNCTION__)
+   * \param filename             The file the call site is located in (typically __FILE__)
+   * \param line                 The line of the call site (typically __LINE__)
+   * \param static_description   An optional description that is the same for all messages from this call site
+   */
+  constexpr tCallSite(const char *function, const char *filename, unsigned int line, const char *static_description = 0)
+    : function(function),
+      filename(filename),
+      line(line),
+      static_description(static_description),
+      static_description_length(static_description ? internal::StringLength(static_description) : 0),
+      texts(nullptr),
+      all_texts(nullptr)
+  {}
+
+  /*! Get the description that is the same for all messages from this call site
+   *
+   * \returns The static description or zero if the description is given per message
+   */
+  inline const char *StaticDescription() const
+  {
+    return this->static_description;
+  }
+
+  /*! Get the length of the description that is the same for all messages from this call site
+   *
+   * \returns The length of the static description
+   */
+  inline size_t StaticDescriptionLength() const
+  {
+    return this->static_description_length;
+  }
+
+  /*! Get the texts of a prefix template rendered for this call site
+   *
+   * \param prefix_template   The prefix template
+   *
+   * \returns The texts indexed like the call site texts of the template
+   */
+  inline const std::string *Texts(const tPrefixTemplate &prefix_template)
+  {
+    const tTexts *texts = this->texts.load(std::memory_order_acquire);
+    if (!texts || texts->prefix_template_id != prefix_template.Id())
+    {
+      texts = this->PrepareTexts(prefix_template);
+    }
+    return texts->texts.data();
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  struct tTexts
+  {
+    unsigned int prefix_template_id;
+    std::vector<std::string> texts;
+    const tTexts *next;
+  };
+
+  const char *function;
+  const char *filename;
+  unsigned int line;
+  const char *static_description;
+  size_t static_description_length;
+
+  std::atomic<const tTexts *> texts;
+  const tTexts *all_texts;  // all texts ever rendered, guarded by a global mutex
+
+  tCallSite(const tCallSite &other);
+
+  tCallSite &operator = (const tCallSite &other);
+
+  const tTexts *PrepareTexts(const tPrefixTemplate &prefix_template);
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
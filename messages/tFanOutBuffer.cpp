@@ -45,6 +45,7 @@ extern "C"
 // Internal includes with ""
 //----------------------------------------------------------------------
 #include "rrlib/logging/configuration/tDomainRegistry.h"
+#include "rrlib/logging/messages/tRecordBuffer.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -86,6 +87,7 @@ tFanOutBuffer::tFanOutBuffer() :
 //----------------------------------------------------------------------
 void tFanOutBuffer::SetColor(tFormattingBufferEffect effect, tFormattingBufferColor color)
 {
+  this->Flush();
   for (auto it = this->formatting_buffers.begin(); it != this->formatting_buffers.end(); ++it)
   {
     it->SetColor(effect, color);
@@ -97,6 +99,7 @@ void tFanOutBuffer::SetColor(tFormattingBufferEffect effect, tFormattingBufferCo
 //----------------------------------------------------------------------
 void tFanOutBuffer::ResetColor()
 {
+  this->Flush();
   for (auto it = this->formatting_buffers.begin(); it != this->formatting_buffers.end(); ++it)
   {
     it->ResetColor();
@@ -108,6 +111,7 @@ void tFanOutBuffer::ResetColor()
 //----------------------------------------------------------------------
 void tFanOutBuffer::InitializeMultiLinePadding()
 {
+  this->Flush();
   for (auto it = this->formatting_buffers.begin(); it != this->formatting_buffers.end(); ++it)
   {
     it->InitializeMultiLinePadding();
@@ -119,6 +123,7 @@ void tFanOutBuffer::InitializeMultiLinePadding()
 //----------------------------------------------------------------------
 void tFanOutBuffer::MarkEndOfPrefixForMultiLinePadding()
 {
+  this->Flush();
   for (auto it = this->formatting_buffers.begin(); it != this->formatting_buffers.end(); ++it)
   {
     it->MarkEndOfPrefixForMultiLinePadding();
@@ -126,33 +131,44 @@ void tFanOutBuffer::MarkEndOfPrefixForMultiLinePadding()
 }
 
 //----------------------------------------------------------------------
-// tFanOutBuffer overflow
+// tFanOutBuffer WriteRecord
 //----------------------------------------------------------------------
-tFanOutBuffer::int_type tFanOutBuffer::overflow(int_type c)
+void tFanOutBuffer::WriteRecord(const tRecordBuffer &record)
 {
-  if (c == traits_type::eof())
+  this->Flush();
+
+  for (auto it = this->formatting_buffers.begin(); it != this->formatting_buffers.end(); ++it)
+  {
+    it->WriteRecord(record);
+    it->pubsync();
+  }
+  for (auto it = this->buffers.begin(); it != this->buffers.end(); ++it)
+  {
+    record.WriteTo(**it);
+    (*it)->pubsync();
+  }
+}
+
+//----------------------------------------------------------------------
+// tFanOutBuffer WriteBlock
+//----------------------------------------------------------------------
+void tFanOutBuffer::WriteBlock(const char *data, size_t length)
+{
+  if (!length)
   {
-    return traits_type::eof();
+    return;
   }
 
-  this->SetEndsWithNewline(c == '\n');
+  this->SetEndsWithNewline(data[length - 1] == '\n');
 
-  int_type result = c;
   for (auto it = this->formatting_buffers.begin(); it != this->formatting_buffers.end(); ++it)
   {
-    if (it->sputc(c) == traits_type::eof())
-    {
-      result = traits_type::eof();
-    }
+    it->sputn(data, length);
   }
   for (auto it = this->buffers.begin(); it != this->buffers.end(); ++it)
   {
-    if ((*it)->sputc(c) == traits_type::eof())
-    {
-      result = traits_type::eof();
-    }
+    (*it)->sputn(data, length);
   }
-  return result;
 }
 
 //----------------------------------------------------------------------
@@ -160,6 +176,8 @@ tFanOutBuffer::int_type tFanOutBuffer::overflow(int_type c)
 //----------------------------------------------------------------------
 int tFanOutBuffer::sync()
 {
+  this->Flush();
+
   int result = 0;
   for (auto it = this->formatting_buffers.begin(); it != this->formatting_buffers.end(); ++it)
   {
@@ -146,6 +146,13 @@ public:
 
   virtual void MarkEndOfPrefixForMultiLinePadding();
 
+  /*! Write a complete record to all sinks
+   *
+   * Each sink gets the record in a single call and is synced afterwards.
+   *
+   * \param record   The record to be written
+   */
+  virtual void WriteRecord(const tRecordBuffer &record);
 
 //----------------------------------------------------------------------
 // Private fields and methods
@@ -155,7 +162,7 @@ private:
   std::vector<tFormattingBuffer> formatting_buffers;
   std::vector<std::streambuf *> buffers;
 
-  virtual int_type overflow(int_type c);
+  virtual void WriteBlock(const char *data, size_t length);
 
   virtual int sync();
 
@@ -33,8 +33,8 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
-#include <cstdio>
 #include <cstring>
+#include <algorithm>
 
 extern "C"
 {
@@ -45,6 +45,8 @@ extern "C"
 // Internal includes with ""
 //----------------------------------------------------------------------
 #include "rrlib/logging/configuration/tDomainRegistry.h"
+#include "rrlib/logging/messages/tRecordBuffer.h"
+#include "rrlib/logging/messages/find_newline.h"
 #include "rrlib/util/fstream/fileno.h"
 
 //----------------------------------------------------------------------
@@ -86,9 +88,11 @@ tFormattingBuffer::tFormattingBuffer(std::streambuf *sink) :
   pad_before_next_character(false)
 {
   this->is_a_tty = isatty(util::GetFileDescriptor(this->sink));
+  this->setp(this->buffer, this->buffer + sizeof(this->buffer));
 }
 
 tFormattingBuffer::tFormattingBuffer(const tFormattingBuffer &other) :
+  std::streambuf(),
   sink(other.sink),
   ends_with_newline(other.ends_with_newline),
   multi_line_pad_width(other.multi_line_pad_width),
@@ -96,6 +100,10 @@ tFormattingBuffer::tFormattingBuffer(const tFormattingBuffer &other) :
   pad_before_next_character(other.pad_before_next_character)
 {
   this->is_a_tty = isatty(util::GetFileDescriptor(this->sink));
+  const size_t pending = other.pptr() - other.pbase();
+  std::memcpy(this->buffer, other.pbase(), pending);
+  this->setp(this->buffer, this->buffer + sizeof(this->buffer));
+  this->pbump(static_cast<int>(pending));
 }
 
 //----------------------------------------------------------------------
@@ -111,6 +119,10 @@ tFormattingBuffer &tFormattingBuffer::operator = (const tFormattingBuffer &other
     this->collect_multi_line_pad_width = other.collect_multi_line_pad_width;
     this->pad_before_next_character = other.pad_before_next_character;
     this->is_a_tty = isatty(util::GetFileDescriptor(this->sink));
+    const size_t pending = other.pptr() - other.pbase();
+    std::memcpy(this->buffer, other.pbase(), pending);
+    this->setp(this->buffer, this->buffer + sizeof(this->buffer));
+    this->pbump(static_cast<int>(pending));
   }
   return *this;
 }
@@ -120,11 +132,11 @@ tFormattingBuffer &tFormattingBuffer::operator = (const tFormattingBuffer &other
 //----------------------------------------------------------------------
 void tFormattingBuffer::SetColor(tFormattingBufferEffect effect, tFormattingBufferColor color)
 {
-  char control_sequence[16];
-  const size_t length = snprintf(control_sequence, sizeof(control_sequence), "\033[;%u;3%um", effect, color);
   if (is_a_tty)
   {
-    this->sink->sputn(control_sequence, length);
+    const tColorControlSequence control_sequence = GetColorControlSequence(effect, color);
+    this->Flush();
+    this->sink->sputn(control_sequence.sequence, sizeof(control_sequence.sequence));
   }
 }
 
@@ -133,11 +145,10 @@ void tFormattingBuffer::SetColor(tFormattingBufferEffect effect, tFormattingBuff
 //----------------------------------------------------------------------
 void tFormattingBuffer::ResetColor()
 {
-  const char *control_sequence = "\033[;0m";
-  const size_t length = strlen(control_sequence);
   if (is_a_tty)
   {
-    this->sink->sputn(control_sequence, length);
+    this->Flush();
+    this->sink->sputn(cRESET_COLOR_CONTROL_SEQUENCE, cRESET_COLOR_CONTROL_SEQUENCE_LENGTH);
   }
 }
 
@@ -150,6 +161,7 @@ void tFormattingBuffer::InitializeMultiLinePadding()
   {
     return;
   }
+  this->Flush();
   this->multi_line_pad_width = 0;
   this->collect_multi_line_pad_width = true;
   this->pad_before_next_character = false;
@@ -160,43 +172,126 @@ void tFormattingBuffer::InitializeMultiLinePadding()
 //----------------------------------------------------------------------
 void tFormattingBuffer::MarkEndOfPrefixForMultiLinePadding()
 {
+  this->Flush();
   this->collect_multi_line_pad_width = false;
 }
 
 //----------------------------------------------------------------------
-// tFormattingBuffer overflow
+// tFormattingBuffer WriteRecord
 //----------------------------------------------------------------------
-tFormattingBuffer::int_type tFormattingBuffer::overflow(int_type c)
+void tFormattingBuffer::WriteRecord(const tRecordBuffer &record)
 {
-  if (c == traits_type::eof())
+  this->Flush();
+  record.WriteFormattedTo(*this->sink, this->is_a_tty);
+}
+
+//----------------------------------------------------------------------
+// tFormattingBuffer Flush
+//----------------------------------------------------------------------
+void tFormattingBuffer::Flush()
+{
+  const size_t length = this->pptr() - this->pbase();
+  if (length)
   {
-    return traits_type::eof();
+    this->setp(this->buffer, this->buffer + sizeof(this->buffer));
+    this->WriteBlock(this->buffer, length);
   }
+}
 
-  this->SetEndsWithNewline(c == '\n');
+//----------------------------------------------------------------------
+// tFormattingBuffer WriteBlock
+//----------------------------------------------------------------------
+void tFormattingBuffer::WriteBlock(const char *data, size_t length)
+{
+  if (!length)
+  {
+    return;
+  }
 
-  int result = c;
-  if (this->pad_before_next_character)
+  // Process line by line: padding is only inserted before the first character following a newline
+  const char *end = data + length;
+  while (data != end)
   {
-    for (size_t i = 0; i < this->multi_line_pad_width; ++i)
+    if (this->pad_before_next_character)
+    {
+      this->WritePadding(this->multi_line_pad_width);
+      this->pad_before_next_character = false;
+    }
+
+    const char *newline = FindNewline(data, end);
+    const char *line_end = newline ? newline + 1 : end;
+    this->sink->sputn(data, line_end - data);
+
+    if (this->collect_multi_line_pad_width)
+    {
+      this->multi_line_pad_width = newline ? 0 : this->multi_line_pad_width + (line_end - data);
+    }
+    else
     {
-      result = this->sink->sputc(' ');
+      this->pad_before_next_character = newline;
     }
-    this->pad_before_next_character = false;
+
+    data = line_end;
   }
 
-  result = this->sink->sputc(c);
+  this->SetEndsWithNewline(end[-1] == '\n');
+}
 
-  if (this->collect_multi_line_pad_width)
+//----------------------------------------------------------------------
+// tFormattingBuffer WritePadding
+//----------------------------------------------------------------------
+void tFormattingBuffer::WritePadding(size_t width)
+{
+  static const char spaces[] = "                                                                ";
+  while (width > 0)
   {
-    this->multi_line_pad_width = this->EndsWithNewline() ? 0 : this->multi_line_pad_width + 1;
+    const size_t length = std::min(width, sizeof(spaces) - 1);
+    this->sink->sputn(spaces, length);
+    width -= length;
   }
-  else
+}
+
+//----------------------------------------------------------------------
+// tFormattingBuffer overflow
+//----------------------------------------------------------------------
+tFormattingBuffer::int_type tFormattingBuffer::overflow(int_type c)
+{
+  this->Flush();
+  if (c == traits_type::eof())
   {
-    this->pad_before_next_character = this->EndsWithNewline();
+    return traits_type::not_eof(c);
   }
 
-  return result;
+  *this->pptr() = traits_type::to_char_type(c);
+  this->pbump(1);
+  return c;
+}
+
+//----------------------------------------------------------------------
+// tFormattingBuffer xsputn
+//----------------------------------------------------------------------
+std::streamsize tFormattingBuffer::xsputn(const char *data, std::streamsize length)
+{
+  if (length <= this->epptr() - this->pptr())
+  {
+    std::memcpy(this->pptr(), data, length);
+    this->pbump(static_cast<int>(length));
+    return length;
+  }
+
+  // Large blocks are processed directly instead of being copied in chunks
+  this->Flush();
+  this->WriteBlock(data, length);
+  return length;
+}
+
+//----------------------------------------------------------------------
+// tFormattingBuffer sync
+//----------------------------------------------------------------------
+int tFormattingBuffer::sync()
+{
+  this->Flush();
+  return 0;
 }
 
 //----------------------------------------------------------------------
@@ -62,6 +62,8 @@ namespace logging
 //----------------------------------------------------------------------
 // Forward declarations / typedefs / enums
 //----------------------------------------------------------------------
+class tRecordBuffer;
+
 enum tFormattingBufferEffect
 {
   eSBE_REGULAR,
@@ -87,6 +89,33 @@ enum tFormattingBufferColor
   eSBC_DIMENSION
 };
 
+//! The control sequence that sets an effect and color on terminals
+struct tColorControlSequence
+{
+  char sequence[8];
+};
+
+/*! Get the control sequence for an effect and color
+ *
+ * All effects and colors are single digits, so each sequence has the
+ * same length and can be composed at compile time.
+ *
+ * \param effect   The effect to enable
+ * \param color    The foreground color to use
+ *
+ * \returns The corresponding control sequence (not null-terminated)
+ */
+constexpr tColorControlSequence GetColorControlSequence(tFormattingBufferEffect effect, tFormattingBufferColor color)
+{
+  return tColorControlSequence {{'\033', '[', ';', static_cast<char>('0' + effect), ';', '3', static_cast<char>('0' + color), 'm'}};
+}
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+constexpr char cRESET_COLOR_CONTROL_SEQUENCE[] = "\033[;0m";
+constexpr size_t cRESET_COLOR_CONTROL_SEQUENCE_LENGTH = sizeof(cRESET_COLOR_CONTROL_SEQUENCE) - 1;
+
 //----------------------------------------------------------------------
 // Class declaration
 //----------------------------------------------------------------------
@@ -94,6 +123,9 @@ enum tFormattingBufferColor
 /*! This stream buffer class implements functionality for decorated
  * terminal output and padding to align its output according to a prefix.
  *
+ * Characters are collected in an own put area and processed blockwise
+ * whenever it is full, the stream is synced or the formatting changes.
+ *
  */
 class tFormattingBuffer : public std::streambuf
 {
@@ -118,7 +150,7 @@ public:
    */
   virtual bool EndsWithNewline() const
   {
-    return this->ends_with_newline;
+    return this->pptr() != this->pbase() ? this->pptr()[-1] == '\n' : this->ends_with_newline;
   }
 
   virtual void SetColor(tFormattingBufferEffect effect, tFormattingBufferColor color);
@@ -129,6 +161,15 @@ public:
 
   virtual void MarkEndOfPrefixForMultiLinePadding();
 
+  /*! Write a complete record to the sink
+   *
+   * The record is written in one block, including control sequences if
+   * the sink is a terminal.
+   *
+   * \param record   The record to be written
+   */
+  virtual void WriteRecord(const tRecordBuffer &record);
+
 //----------------------------------------------------------------------
 // Protected methods
 //----------------------------------------------------------------------
@@ -139,6 +180,30 @@ protected:
     this->ends_with_newline = value;
   }
 
+  /*! Process the content of the put area and reset it
+   *
+   * Must be called before anything is written that bypasses the put
+   * area (e.g. control sequences) or the formatting state changes.
+   */
+  void Flush();
+
+  /*! Process a block of characters that leaves the put area
+   *
+   * The block is written to the sink inserting multi-line padding after
+   * each newline. Specializations can override this method to forward
+   * the block somewhere else.
+   *
+   * \param data     The characters to be written
+   * \param length   The number of characters to be written
+   */
+  virtual void WriteBlock(const char *data, size_t length);
+
+  virtual int_type overflow(int_type c);
+
+  virtual std::streamsize xsputn(const char *data, std::streamsize length);
+
+  virtual int sync();
+
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
@@ -153,7 +218,9 @@ private:
   bool collect_multi_line_pad_width;
   bool pad_before_next_character;
 
-  virtual int_type overflow(int_type c);
+  char buffer[256];
+
+  void WritePadding(size_t width);
 
 };
 
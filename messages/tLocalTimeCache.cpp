@@ -0,0 +1,109 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/logging/messages/tLocalTimeCache.cpp
+ *
+ * \author  Tobias Föhst
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#define __rrlib__logging__include_guard__
+#include "rrlib/logging/messages/tLocalTimeCache.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace logging
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+#if __linux__
+
+//----------------------------------------------------------------------
+// tLocalTimeCache constructors
+//----------------------------------------------------------------------
+tLocalTimeCache::tLocalTimeCache()
+  : valid(false),
+    utc_minute_begin(0),
+    local_minute_begin(0),
+    utc_offset(0),
+    local_time()
+{}
+
+//----------------------------------------------------------------------
+// tLocalTimeCache Refresh
+//----------------------------------------------------------------------
+void tLocalTimeCache::Refresh(time_t second)
+{
+  if (localtime_r(&second, &this->local_time))
+  {
+    this->utc_offset = this->local_time.tm_gmtoff;
+  }
+  else
+  {
+    gmtime_r(&second, &this->local_time);
+    this->utc_offset = 0;
+  }
+
+  // Historical offsets are not always full minutes, so the local minute is tracked separately
+  const time_t second_of_utc_minute = (second % 60 + 60) % 60;
+  this->utc_minute_begin = second - second_of_utc_minute;
+  this->local_minute_begin = second + this->utc_offset - this->local_time.tm_sec;
+  this->valid = true;
+}
+
+#endif
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
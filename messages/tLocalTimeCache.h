@@ -0,0 +1,168 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/logging/messages/tLocalTimeCache.h
+ *
+ * \author  Tobias Föhst
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tLocalTimeCache
+ *
+ * \b tLocalTimeCache
+ *
+ * Converting a time to local time (localtime_r) is expensive compared
+ * to formatting the rest of a message. Messages typically follow each
+ * other closely. Timezone and DST changes take effect at full minutes,
+ * so within the same minute only the seconds of the local time change.
+ * tLocalTimeCache keeps the local time of the last second it was moved
+ * to and only calls localtime_r when the minute changes. Like the time
+ * prefix of messages, it is only available on Linux.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__logging__include_guard__
+#error Invalid include directive. Try #include "rrlib/logging/messages.h" instead.
+#endif
+
+#ifndef __rrlib__logging__messages__tLocalTimeCache_h__
+#define __rrlib__logging__messages__tLocalTimeCache_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstddef>
+#include <ctime>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace logging
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+#if __linux__
+
+//! The local time of the last second a thread formatted
+/*! Instances are not thread-safe and meant to be used thread local.
+ *
+ */
+class tLocalTimeCache
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tLocalTimeCache();
+
+  /*! Move the cache to another second
+   *
+   * \param second   The seconds since the epoch
+   *
+   * \returns Whether more than the seconds of the local time changed
+   */
+  inline bool Update(time_t second)
+  {
+    const time_t second_of_local_minute = second + this->utc_offset - this->local_minute_begin;
+    if (this->valid && second >= this->utc_minute_begin && second < this->utc_minute_begin + 60 && second_of_local_minute >= 0 && second_of_local_minute < 60)
+    {
+      this->local_time.tm_sec = static_cast<int>(second_of_local_minute);
+      return false;
+    }
+    this->Refresh(second);
+    return true;
+  }
+
+  /*! Get the local time of the current second
+   *
+   * \returns The broken down local time
+   */
+  inline const tm &LocalTime() const
+  {
+    return this->local_time;
+  }
+
+  /*! Get the offset of the local time to UTC
+   *
+   * \returns The offset in seconds (east of UTC is positive)
+   */
+  inline long UTCOffset() const
+  {
+    return this->utc_offset;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  bool valid;
+  time_t utc_minute_begin;
+  time_t local_minute_begin;
+  long utc_offset;
+  tm local_time;
+
+  void Refresh(time_t second);
+
+};
+
+#endif
+
+/*! Format a number with a fixed number of decimal digits
+ *
+ * \param target   The first of the digits to write
+ * \param value    The number (higher digits are dropped)
+ * \param count    The number of digits
+ */
+inline void FormatDigits(char *target, unsigned long long value, size_t count)
+{
+  for (size_t i = count; i-- > 0;)
+  {
+    target[i] = '0' + value % 10;
+    value /= 10;
+  }
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
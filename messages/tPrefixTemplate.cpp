@@ -0,0 +1,257 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/logging/messages/tPrefixTemplate.cpp
+ *
+ * \author  Tobias Föhst
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#define __rrlib__logging__include_guard__
+#include "rrlib/logging/messages/tPrefixTemplate.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include <cctype>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace logging
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+namespace
+{
+std::atomic<unsigned int> next_prefix_template_id(1);
+
+std::vector<tPrefixTemplate> CreateDefaultTemplates()
+{
+  std::vector<tPrefixTemplate> templates;
+  for (unsigned int flags = 0; flags < 16; ++flags)
+  {
+    std::string prefix_template;
+    prefix_template.append(flags & 0x1 ? "%T " : "");
+    prefix_template.append(flags & 0x2 ? "%N " : "");
+    prefix_template.append(flags & 0x4 ? "%L " : "");
+    prefix_template.append("%D::%F ");
+    prefix_template.append(flags & 0x8 ? "[%f:%l] " : "");
+    prefix_template.append(">> ");
+    templates.emplace_back(prefix_template);
+  }
+  return templates;
+}
+
+bool IsWhitespace(const tPrefixTemplate &prefix_template, const tPrefixTemplate::tOperation &operation)
+{
+  for (uint32_t i = 0; i < operation.length; ++i)
+  {
+    if (!std::isspace(static_cast<unsigned char>(prefix_template.Text()[operation.offset + i])))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//----------------------------------------------------------------------
+// tPrefixTemplate constructors
+//----------------------------------------------------------------------
+tPrefixTemplate::tPrefixTemplate(const std::string &prefix_template)
+  : id(next_prefix_template_id++),
+    prefix_template(prefix_template)
+{
+  std::vector<tCallSiteItem> pending;
+  size_t literal_begin = 0;
+  for (size_t i = 0; i < prefix_template.length(); ++i)
+  {
+    if (prefix_template[i] != '%' || i + 1 == prefix_template.length())
+    {
+      continue;
+    }
+
+    this->AddText(pending, prefix_template.data() + literal_begin, i - literal_begin);
+    const char field = prefix_template[++i];
+    literal_begin = i + 1;
+    switch (field)
+    {
+    case 'T':
+      this->FlushPending(pending);
+      this->operations.push_back(tOperation {tOperationType::TIME, 0, 0});
+      break;
+    case 'N':
+      this->FlushPending(pending);
+      this->operations.push_back(tOperation {tOperationType::NAME, 0, 0});
+      break;
+    case 'L':
+      this->FlushPending(pending);
+      this->operations.push_back(tOperation {tOperationType::LEVEL, 0, 0});
+      break;
+    case 'D':
+      this->FlushPending(pending);
+      this->operations.push_back(tOperation {tOperationType::DESCRIPTION, 0, 0});
+      break;
+    case 'F':
+      pending.push_back(tCallSiteItem {tCallSiteField::FUNCTION, 0, 0});
+      break;
+    case 'f':
+      pending.push_back(tCallSiteItem {tCallSiteField::FILENAME, 0, 0});
+      break;
+    case 'l':
+      pending.push_back(tCallSiteItem {tCallSiteField::LINE, 0, 0});
+      break;
+    case '%':
+      this->AddText(pending, "%", 1);
+      break;
+    default:
+      // Unknown fields are kept as they are
+      this->AddText(pending, prefix_template.data() + i - 1, 2);
+    }
+  }
+  this->AddText(pending, prefix_template.data() + literal_begin, prefix_template.length() - literal_begin);
+  this->FlushPending(pending);
+
+  // The level color starts behind a leading time field and covers the rest of the prefix
+  auto color_begin = this->operations.begin();
+  while (color_begin != this->operations.end() && (color_begin->type == tOperationType::TIME || (color_begin->type == tOperationType::TEXT && IsWhitespace(*this, *color_begin))))
+  {
+    ++color_begin;
+  }
+  this->operations.insert(color_begin, tOperation {tOperationType::COLOR, 0, 0});
+  this->operations.push_back(tOperation {tOperationType::RESET_COLOR, 0, 0});
+}
+
+//----------------------------------------------------------------------
+// tPrefixTemplate Default
+//----------------------------------------------------------------------
+const tPrefixTemplate &tPrefixTemplate::Default(bool prints_time, bool prints_name, bool prints_level, bool prints_location)
+{
+  static const std::vector<tPrefixTemplate> templates(CreateDefaultTemplates());
+  return templates[(prints_time ? 0x1 : 0) | (prints_name ? 0x2 : 0) | (prints_level ? 0x4 : 0) | (prints_location ? 0x8 : 0)];
+}
+
+//----------------------------------------------------------------------
+// tPrefixTemplate RenderCallSiteText
+//----------------------------------------------------------------------
+std::string tPrefixTemplate::RenderCallSiteText(size_t index, const char *function, const char *filename, unsigned int line) const
+{
+  std::string text;
+  const std::vector<tCallSiteItem> &items = this->call_site_texts[index];
+  for (auto it = items.begin(); it != items.end(); ++it)
+  {
+    switch (it->field)
+    {
+    case tCallSiteField::TEXT:
+      text.append(this->text, it->offset, it->length);
+      break;
+    case tCallSiteField::FUNCTION:
+      text.append(function);
+      break;
+    case tCallSiteField::FILENAME:
+      text.append(filename);
+      break;
+    case tCallSiteField::LINE:
+      text.append(std::to_string(line));
+      break;
+    }
+  }
+  return text;
+}
+
+//----------------------------------------------------------------------
+// tPrefixTemplate AddText
+//----------------------------------------------------------------------
+void tPrefixTemplate::AddText(std::vector<tCallSiteItem> &pending, const char *data, size_t length)
+{
+  if (!length)
+  {
+    return;
+  }
+
+  // Adjacent pieces of literal text are merged (e.g. around an escaped %)
+  if (!pending.empty() && pending.back().field == tCallSiteField::TEXT && pending.back().offset + pending.back().length == this->text.length())
+  {
+    pending.back().length += length;
+  }
+  else
+  {
+    pending.push_back(tCallSiteItem {tCallSiteField::TEXT, static_cast<uint32_t>(this->text.length()), static_cast<uint32_t>(length)});
+  }
+  this->text.append(data, length);
+}
+
+//----------------------------------------------------------------------
+// tPrefixTemplate FlushPending
+//----------------------------------------------------------------------
+void tPrefixTemplate::FlushPending(std::vector<tCallSiteItem> &pending)
+{
+  if (pending.empty())
+  {
+    return;
+  }
+
+  if (pending.size() == 1 && pending.front().field == tCallSiteField::TEXT)
+  {
+    this->operations.push_back(tOperation {tOperationType::TEXT, pending.front().offset, pending.front().length});
+  }
+  else
+  {
+    this->operations.push_back(tOperation {tOperationType::CALL_SITE_TEXT, static_cast<uint32_t>(this->call_site_texts.size()), 0});
+    this->call_site_texts.push_back(pending);
+  }
+  pending.clear();
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,216 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/logging/messages/tPrefixTemplate.h
+ *
+ * \author  Tobias Föhst
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tPrefixTemplate
+ *
+ * \b tPrefixTemplate
+ *
+ * tPrefixTemplate describes the layout of the prefix of each message
+ * in a domain. It is given as a string with the following fields:
+ *
+ *   %T   the time
+ *   %N   the full qualified domain name
+ *   %L   the message level
+ *   %D   the log description (e.g. the class of the sending object)
+ *   %F   the function that sent the message
+ *   %f   the file that contains the call site
+ *   %l   the line of the call site
+ *   %%   a literal %
+ *
+ * Any other text is copied literally. E.g. the layout used by default
+ * with all fields enabled is "%T %N %L %D::%F [%f:%l] >> ".
+ *
+ * On terminals the prefix is colored according to the message level,
+ * starting after a leading time field.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__logging__include_guard__
+#error Invalid include directive. Try #include "rrlib/logging/messages.h" instead.
+#endif
+
+#ifndef __rrlib__logging__messages__tPrefixTemplate_h__
+#define __rrlib__logging__messages__tPrefixTemplate_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace logging
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! A prefix layout compiled into a list of operations
+/*! The template string is parsed once into a compact list of
+ *  operations that are executed for each message. Consecutive fields
+ *  that are constant for a call site (function, file, line and literal
+ *  text) are merged into one operation. tCallSite renders these texts
+ *  once per template, so they are emitted with a single copy.
+ *
+ *  Instances are immutable and identified by a unique id.
+ */
+class tPrefixTemplate
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  enum class tOperationType
+  {
+    TEXT,            //!< Literal text
+    CALL_SITE_TEXT,  //!< Text that is constant for each call site
+    TIME,            //!< The current time
+    COLOR,           //!< Switch to the color of the message level
+    NAME,            //!< The full qualified domain name
+    LEVEL,           //!< The message level
+    DESCRIPTION,     //!< The log description
+    RESET_COLOR      //!< Switch back to the default color
+  };
+
+  struct tOperation
+  {
+    tOperationType type;
+    uint32_t offset;  //!< The offset into the text (TEXT) or the index of the call site text (CALL_SITE_TEXT)
+    uint32_t length;  //!< The length of the text (TEXT)
+  };
+
+  /*! The ctor of tPrefixTemplate
+   *
+   * \param prefix_template   The template string (see file documentation)
+   */
+  explicit tPrefixTemplate(const std::string &prefix_template);
+
+  /*! Get the prefix template equivalent to the prints_* settings of a domain
+   *
+   * \param prints_time       Whether the time should be printed
+   * \param prints_name       Whether the domain name should be printed
+   * \param prints_level      Whether the message level should be printed
+   * \param prints_location   Whether the location of the call site should be printed
+   *
+   * \returns A template that lives until the end of the program
+   */
+  static const tPrefixTemplate &Default(bool prints_time, bool prints_name, bool prints_level, bool prints_location);
+
+  inline unsigned int Id() const
+  {
+    return this->id;
+  }
+
+  inline const std::string &Template() const
+  {
+    return this->prefix_template;
+  }
+
+  inline const std::vector<tOperation> &Operations() const
+  {
+    return this->operations;
+  }
+
+  inline const char *Text() const
+  {
+    return this->text.data();
+  }
+
+  inline size_t NumberOfCallSiteTexts() const
+  {
+    return this->call_site_texts.size();
+  }
+
+  /*! Render one of the texts that are constant for a call site
+   *
+   * \param index      The index of the call site text
+   * \param function   The function of the call site
+   * \param filename   The file of the call site
+   * \param line       The line of the call site
+   *
+   * \returns The rendered text
+   */
+  std::string RenderCallSiteText(size_t index, const char *function, const char *filename, unsigned int line) const;
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  enum class tCallSiteField
+  {
+    TEXT,
+    FUNCTION,
+    FILENAME,
+    LINE
+  };
+
+  struct tCallSiteItem
+  {
+    tCallSiteField field;
+    uint32_t offset;
+    uint32_t length;
+  };
+
+  unsigned int id;
+  std::string prefix_template;
+  std::string text;
+  std::vector<tOperation> operations;
+  std::vector<std::vector<tCallSiteItem>> call_site_texts;
+
+  void AddText(std::vector<tCallSiteItem> &pending, const char *data, size_t length);
+
+  void FlushPending(std::vector<tCallSiteItem> &pending);
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
@@ -0,0 +1,340 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/logging/messages/tRecordBuffer.cpp
+ *
+ * \author  Tobias Föhst
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#define __rrlib__logging__include_guard__
+#include "rrlib/logging/messages/tRecordBuffer.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/logging/configuration/tDomainRegistry.h"
+#include "rrlib/logging/messages/find_newline.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace logging
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+const size_t cINITIAL_RECORD_BUFFER_SIZE = 512;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// tRecordBuffer constructors
+//----------------------------------------------------------------------
+tRecordBuffer::tRecordBuffer() :
+  tFormattingBuffer(NULL),
+  storage(cINITIAL_RECORD_BUFFER_SIZE),
+  pad_multi_line_messages(false),
+  prefix_begin(0),
+  prefix_end(0),
+  multi_line_pad_width(0)
+{
+  this->Clear();
+}
+
+//----------------------------------------------------------------------
+// tRecordBuffer Clear
+//----------------------------------------------------------------------
+void tRecordBuffer::Clear()
+{
+  this->setp(this->storage.data(), this->storage.data() + this->storage.size());
+  this->control_sequences.clear();
+  this->pad_multi_line_messages = false;
+  this->prefix_begin = 0;
+  this->prefix_end = 0;
+  this->multi_line_pad_width = 0;
+  this->rendered[0] = false;
+  this->rendered[1] = false;
+}
+
+//----------------------------------------------------------------------
+// tRecordBuffer EndsWithNewline
+//----------------------------------------------------------------------
+bool tRecordBuffer::EndsWithNewline() const
+{
+  return this->pptr() == this->pbase() || this->pptr()[-1] == '\n';
+}
+
+//----------------------------------------------------------------------
+// tRecordBuffer SetColor
+//----------------------------------------------------------------------
+void tRecordBuffer::SetColor(tFormattingBufferEffect effect, tFormattingBufferColor color)
+{
+  const tColorControlSequence control_sequence = GetColorControlSequence(effect, color);
+  this->AddControlSequence(control_sequence.sequence, sizeof(control_sequence.sequence));
+}
+
+//----------------------------------------------------------------------
+// tRecordBuffer ResetColor
+//----------------------------------------------------------------------
+void tRecordBuffer::ResetColor()
+{
+  this->AddControlSequence(cRESET_COLOR_CONTROL_SEQUENCE, cRESET_COLOR_CONTROL_SEQUENCE_LENGTH);
+}
+
+//----------------------------------------------------------------------
+// tRecordBuffer InitializeMultiLinePadding
+//----------------------------------------------------------------------
+void tRecordBuffer::InitializeMultiLinePadding()
+{
+  this->pad_multi_line_messages = tDomainRegistry::Instance().GetPadMultiLineMessages();
+  this->prefix_begin = this->pptr() - this->pbase();
+  this->prefix_end = this->prefix_begin;
+}
+
+//----------------------------------------------------------------------
+// tRecordBuffer MarkEndOfPrefixForMultiLinePadding
+//----------------------------------------------------------------------
+void tRecordBuffer::MarkEndOfPrefixForMultiLinePadding()
+{
+  this->prefix_end = this->pptr() - this->pbase();
+
+  // Following lines are padded to the width of the last line of the prefix
+  size_t line_begin = this->prefix_begin;
+  for (size_t i = this->prefix_begin; i < this->prefix_end; ++i)
+  {
+    if (this->pbase()[i] == '\n')
+    {
+      line_begin = i + 1;
+    }
+  }
+  this->multi_line_pad_width = this->prefix_end - line_begin;
+}
+
+//----------------------------------------------------------------------
+// tRecordBuffer AppendFormatted
+//----------------------------------------------------------------------
+void tRecordBuffer::AppendFormatted(const char *fmt, va_list printf_args)
+{
+  // Usually the remaining space is large enough and the text is formatted in a single pass
+  va_list printf_args_copy;
+  va_copy(printf_args_copy, printf_args);
+  const int length = vsnprintf(this->pptr(), this->epptr() - this->pptr(), fmt, printf_args_copy);
+  va_end(printf_args_copy);
+
+  if (length < 0)
+  {
+    return;
+  }
+  if (this->pptr() + length >= this->epptr())
+  {
+    this->Reserve(length + 1);
+    vsnprintf(this->pptr(), length + 1, fmt, printf_args);
+  }
+  this->pbump(length);
+}
+
+//----------------------------------------------------------------------
+// tRecordBuffer WriteTo
+//----------------------------------------------------------------------
+void tRecordBuffer::WriteTo(std::streambuf &sink) const
+{
+  sink.sputn(this->pbase(), this->pptr() - this->pbase());
+}
+
+//----------------------------------------------------------------------
+// tRecordBuffer WriteFormattedTo
+//----------------------------------------------------------------------
+void tRecordBuffer::WriteFormattedTo(std::streambuf &sink, bool colored) const
+{
+  colored = colored && !this->control_sequences.empty();
+  const bool padded = this->pad_multi_line_messages && this->multi_line_pad_width > 0;
+  if (!colored && !padded)
+  {
+    this->WriteTo(sink);
+    return;
+  }
+
+  // Each variant is rendered once per record, no matter how many sinks use it
+  if (!this->rendered[colored])
+  {
+    this->Render(this->renderings[colored], colored);
+    this->rendered[colored] = true;
+  }
+  sink.sputn(this->renderings[colored].data(), this->renderings[colored].length());
+}
+
+//----------------------------------------------------------------------
+// tRecordBuffer AddControlSequence
+//----------------------------------------------------------------------
+void tRecordBuffer::AddControlSequence(const char *sequence, size_t length)
+{
+  tControlSequence control_sequence;
+  control_sequence.position = this->pptr() - this->pbase();
+  control_sequence.length = std::min(length, sizeof(control_sequence.sequence));
+  std::memcpy(control_sequence.sequence, sequence, control_sequence.length);
+  this->control_sequences.push_back(control_sequence);
+}
+
+//----------------------------------------------------------------------
+// tRecordBuffer Render
+//----------------------------------------------------------------------
+void tRecordBuffer::Render(std::string &rendering, bool colored) const
+{
+  const char *text = this->pbase();
+  const char *const end = this->pptr();
+  const bool padded = this->pad_multi_line_messages;
+  if (padded)
+  {
+    this->padding.assign(this->multi_line_pad_width, ' ');
+  }
+
+  // Collect the segments of the output first and copy them in one go afterwards
+  this->segments.clear();
+  size_t length = 0;
+  bool pad_before_next_character = false;
+  auto control_sequence = this->control_sequences.begin();
+  while (true)
+  {
+    for (; control_sequence != this->control_sequences.end() && this->pbase() + control_sequence->position == text; ++control_sequence)
+    {
+      if (colored)
+      {
+        this->segments.push_back(tSegment {control_sequence->sequence, control_sequence->length});
+        length += control_sequence->length;
+      }
+    }
+    if (text == end)
+    {
+      break;
+    }
+
+    if (pad_before_next_character)
+    {
+      this->segments.push_back(tSegment {this->padding.data(), this->padding.length()});
+      length += this->padding.length();
+      pad_before_next_character = false;
+    }
+
+    // Up to the next control sequence or the next newline (inclusive)
+    const char *segment_end = control_sequence != this->control_sequences.end() ? this->pbase() + control_sequence->position : end;
+    const char *newline = FindNewline(text, segment_end);
+    const char *next = newline ? newline + 1 : segment_end;
+    this->segments.push_back(tSegment {text, static_cast<size_t>(next - text)});
+    length += next - text;
+
+    // Only lines of the message body are padded, not the ones of the prefix
+    pad_before_next_character = padded && newline && static_cast<size_t>(newline - this->pbase()) >= this->prefix_end;
+    text = next;
+  }
+
+  rendering.resize(length);
+  char *target = &rendering[0];
+  for (auto it = this->segments.begin(); it != this->segments.end(); ++it)
+  {
+    std::memcpy(target, it->data, it->length);
+    target += it->length;
+  }
+}
+
+//----------------------------------------------------------------------
+// tRecordBuffer Reserve
+//----------------------------------------------------------------------
+void tRecordBuffer::Reserve(size_t length)
+{
+  const size_t used = this->pptr() - this->pbase();
+  if (used + length <= this->storage.size())
+  {
+    return;
+  }
+
+  this->storage.resize(std::max(2 * this->storage.size(), used + length));
+  this->setp(this->storage.data(), this->storage.data() + this->storage.size());
+  this->pbump(static_cast<int>(used));
+}
+
+//----------------------------------------------------------------------
+// tRecordBuffer overflow
+//----------------------------------------------------------------------
+tRecordBuffer::int_type tRecordBuffer::overflow(int_type c)
+{
+  if (c == traits_type::eof())
+  {
+    return traits_type::not_eof(c);
+  }
+
+  this->Reserve(1);
+  *this->pptr() = traits_type::to_char_type(c);
+  this->pbump(1);
+  return c;
+}
+
+//----------------------------------------------------------------------
+// tRecordBuffer xsputn
+//----------------------------------------------------------------------
+std::streamsize tRecordBuffer::xsputn(const char *data, std::streamsize length)
+{
+  this->Reserve(length);
+  std::memcpy(this->pptr(), data, length);
+  this->pbump(static_cast<int>(length));
+  return length;
+}
+
+//----------------------------------------------------------------------
+// tRecordBuffer sync
+//----------------------------------------------------------------------
+int tRecordBuffer::sync()
+{
+  // The record is written to the sinks as a whole when complete
+  return 0;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
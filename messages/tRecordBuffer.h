@@ -0,0 +1,191 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/logging/messages/tRecordBuffer.h
+ *
+ * \author  Tobias Föhst
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tRecordBuffer
+ *
+ * \b tRecordBuffer
+ *
+ * tRecordBuffer collects one complete message (record) before it is
+ * written to the sinks of a domain. Instead of sending control sequences
+ * and padding to each sink while streaming, their positions are stored
+ * along with the plain text. The final output for terminals and other
+ * sinks is rendered at most once per record.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__logging__include_guard__
+#error Invalid include directive. Try #include "rrlib/logging/messages.h" instead.
+#endif
+
+#ifndef __rrlib__logging__messages__tRecordBuffer_h__
+#define __rrlib__logging__messages__tRecordBuffer_h__
+
+#include "rrlib/logging/messages/tFormattingBuffer.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstdarg>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace logging
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! A stream buffer that collects one complete message
+/*! Messages are rendered into an instance of this class without holding
+ *  any lock. It grows as needed and keeps its memory for the following
+ *  messages. Once complete, the record is handed to each sink in a
+ *  single call (see tFanOutBuffer::WriteRecord).
+ *
+ */
+class tRecordBuffer : public tFormattingBuffer
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tRecordBuffer();
+
+  /*! Discard the current record to start a new one
+   */
+  void Clear();
+
+  /*! Find out whether the record ends with a newline
+   *
+   * An empty record is treated as ending with newline, as the former
+   * record did.
+   *
+   * \returns Whether the last character of the record is \n or not
+   */
+  virtual bool EndsWithNewline() const;
+
+  virtual void SetColor(tFormattingBufferEffect effect, tFormattingBufferColor color);
+
+  virtual void ResetColor();
+
+  virtual void InitializeMultiLinePadding();
+
+  virtual void MarkEndOfPrefixForMultiLinePadding();
+
+  /*! Append a printf style formatted text to the record
+   *
+   * The text is formatted directly into the record, so nested messages
+   * (which use their own record buffers) cannot interfere.
+   *
+   * \param fmt           The format string
+   * \param printf_args   The arguments for the format string
+   */
+  void AppendFormatted(const char *fmt, va_list printf_args);
+
+  /*! Write the plain text of the record to a sink
+   *
+   * \param sink   The stream buffer the record is written to
+   */
+  void WriteTo(std::streambuf &sink) const;
+
+  /*! Write the record to a sink with multi-line padding
+   *
+   * \param sink      The stream buffer the record is written to
+   * \param colored   Whether the control sequences for colored output should be included
+   */
+  void WriteFormattedTo(std::streambuf &sink, bool colored) const;
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  struct tControlSequence
+  {
+    size_t position;
+    char sequence[16];
+    size_t length;
+  };
+
+  std::vector<char> storage;
+  std::vector<tControlSequence> control_sequences;
+
+  bool pad_multi_line_messages;
+  size_t prefix_begin;
+  size_t prefix_end;
+  size_t multi_line_pad_width;
+
+  struct tSegment
+  {
+    const char *data;
+    size_t length;
+  };
+
+  mutable std::string renderings[2];
+  mutable bool rendered[2];
+  mutable std::vector<tSegment> segments;
+  mutable std::string padding;
+
+  void AddControlSequence(const char *sequence, size_t length);
+
+  void Render(std::string &rendering, bool colored) const;
+
+  void Reserve(size_t length);
+
+  virtual int_type overflow(int_type c);
+
+  virtual std::streamsize xsputn(const char *data, std::streamsize length);
+
+  virtual int sync();
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
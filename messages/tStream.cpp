@@ -33,12 +33,23 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
-#include "rrlib/design_patterns/singleton.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <memory>
+#include <type_traits>
+
+#if __linux__
+#include <langinfo.h>
+#endif
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
-#include "rrlib/logging/messages/tFormattingBuffer.h"
+#include "rrlib/logging/messages/tFanOutBuffer.h"
+#include "rrlib/logging/messages/tLocalTimeCache.h"
+#include "rrlib/logging/configuration/tDomainRegistry.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -59,22 +70,149 @@ namespace logging
 //----------------------------------------------------------------------
 // Forward declarations / typedefs / enums
 //----------------------------------------------------------------------
-typedef design_patterns::tSingletonHolder<std::mutex, design_patterns::singleton::PhoenixSingleton> tStreamMutex;
 
 //----------------------------------------------------------------------
 // Const values
 //----------------------------------------------------------------------
+const size_t cMAX_INTEGER_DIGITS = 24;
+const size_t cINITIAL_FLOATING_POINT_BUFFER_SIZE = 64;
+const size_t cMAX_TIMESTAMP_LENGTH = 64;
+const long long cNANOSECONDS_PER_SECOND = 1000000000;
+const char cLOWERCASE_HEX_DIGITS[] = "0123456789abcdef";
+const char cUPPERCASE_HEX_DIGITS[] = "0123456789ABCDEF";
+const char cDECIMAL_DIGIT_PAIRS[] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
 
 //----------------------------------------------------------------------
 // Implementation
 //----------------------------------------------------------------------
 
+namespace
+{
+
+//! A record buffer with the std::ostream that is reused for streaming into it
+struct tRecordStream
+{
+  tRecordBuffer buffer;
+  std::ostream stream;
+  std::locale locale;
+  bool classic_formatting;
+  bool classic_locale;
+
+  tRecordStream() : stream(&buffer), locale(stream.getloc()), classic_formatting(false), classic_locale(locale == std::locale::classic()) {}
+
+  void UpdateLocale(bool classic_formatting)
+  {
+    // In classic mode, std::locale is only touched when the setting changes
+    if (classic_formatting)
+    {
+      if (!this->classic_formatting)
+      {
+        this->Imbue(std::locale::classic());
+        this->classic_formatting = true;
+      }
+      return;
+    }
+
+    // Otherwise, follow the global locale like a new stream would. Comparing is cheap as long as it does not change
+    const std::locale global_locale;
+    if (this->classic_formatting || global_locale != this->locale)
+    {
+      this->Imbue(global_locale);
+      this->classic_formatting = false;
+    }
+  }
+
+  void Imbue(const std::locale &locale)
+  {
+    this->stream.imbue(locale);
+    this->locale = locale;
+    this->classic_locale = locale == std::locale::classic();
+  }
+};
+
+//! The record streams of one thread, one per nesting level of living tStreams, and its buffer for floating point numbers
+struct tRecordStreams
+{
+  std::vector<std::unique_ptr<tRecordStream>> streams;
+  size_t depth;
+  std::vector<char> floating_point_buffer;
+
+  tRecordStreams() : depth(0), floating_point_buffer(cINITIAL_FLOATING_POINT_BUFFER_SIZE) {}
+};
+
+// Plain pointers are never destroyed, so they stay usable while thread_local objects are destroyed and afterwards
+thread_local tRecordStreams *record_streams = NULL;
+thread_local bool record_streams_released = false;
+
+//! Releases the record streams of a thread on its exit
+struct tRecordStreamsRelease
+{
+  ~tRecordStreamsRelease()
+  {
+    delete record_streams;
+    record_streams = NULL;
+    record_streams_released = true;
+  }
+};
+
+thread_local tRecordStreamsRelease record_streams_release;
+
+tRecordStreams &RecordStreams()
+{
+  if (!record_streams)
+  {
+    record_streams = new tRecordStreams();
+
+    // Destructors of other thread_local or static objects might log after the release (see ~tStream)
+    if (!record_streams_released)
+    {
+      static_cast<void>(&record_streams_release);  // constructs the thread_local on first use
+    }
+  }
+  return *record_streams;
+}
+
+tRecordStream &AcquireRecordStream()
+{
+  tRecordStreams &streams = RecordStreams();
+  if (streams.depth == streams.streams.size())
+  {
+    streams.streams.emplace_back(new tRecordStream());
+  }
+  tRecordStream &record_stream = *streams.streams[streams.depth++];
+  record_stream.buffer.Clear();
+
+  // Reset the format state a former message might have changed (e.g. via std::hex)
+  record_stream.stream.clear();
+  record_stream.stream.flags(std::ios_base::dec | std::ios_base::skipws);
+  record_stream.stream.precision(6);
+  record_stream.stream.width(0);
+  record_stream.stream.fill(' ');
+
+  record_stream.UpdateLocale(tDomainRegistry::Instance().GetClassicFormatting());
+  return record_stream;
+}
+
+}
+
 //----------------------------------------------------------------------
 // tStream constructors
 //----------------------------------------------------------------------
-tStream::tStream(std::streambuf *stream_buffer)
-  : stream(stream_buffer),
-    lock(tStreamMutex::Instance())
+tStream::tStream(tFanOutBuffer &target)
+  : target(target),
+    record_buffer(AcquireRecordStream().buffer),
+    stream(record_streams->streams[record_streams->depth - 1]->stream),
+    classic_locale(record_streams->streams[record_streams->depth - 1]->classic_locale)
 {}
 
 //----------------------------------------------------------------------
@@ -82,14 +220,319 @@ tStream::tStream(std::streambuf *stream_buffer)
 //----------------------------------------------------------------------
 tStream::~tStream()
 {
-  tFormattingBuffer *buffer = dynamic_cast<tFormattingBuffer *>(this->stream.rdbuf());
-  if (buffer && buffer->EndsWithNewline())
+  if (!this->record_buffer.EndsWithNewline())
+  {
+    this->stream << '\n';
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(tStreamMutex::Instance());
+    this->target.WriteRecord(this->record_buffer);
+  }
+  // After the release on thread exit, the record streams only live as long as they are used
+  if (--record_streams->depth == 0 && record_streams_released)
+  {
+    delete record_streams;
+    record_streams = NULL;
+  }
+}
+
+//----------------------------------------------------------------------
+// tStream WriteInteger
+//----------------------------------------------------------------------
+void tStream::WriteInteger(unsigned long long bits, unsigned long long magnitude, bool negative)
+{
+  char digits[cMAX_INTEGER_DIGITS];
+  char *const end = digits + sizeof(digits);
+  char *begin = end;
+  switch (this->stream.flags() & std::ios_base::basefield)
+  {
+  case std::ios_base::oct:
+    do
+    {
+      *--begin = '0' + (bits & 7);
+      bits >>= 3;
+    }
+    while (bits);
+    break;
+  case std::ios_base::hex:
+  {
+    const char *hex_digits = (this->stream.flags() & std::ios_base::uppercase) ? cUPPERCASE_HEX_DIGITS : cLOWERCASE_HEX_DIGITS;
+    do
+    {
+      *--begin = hex_digits[bits & 15];
+      bits >>= 4;
+    }
+    while (bits);
+    break;
+  }
+  default:
+    while (magnitude >= 100)
+    {
+      begin -= 2;
+      std::memcpy(begin, cDECIMAL_DIGIT_PAIRS + 2 * (magnitude % 100), 2);
+      magnitude /= 100;
+    }
+    if (magnitude >= 10)
+    {
+      begin -= 2;
+      std::memcpy(begin, cDECIMAL_DIGIT_PAIRS + 2 * magnitude, 2);
+    }
+    else
+    {
+      *--begin = '0' + magnitude;
+    }
+    if (negative)
+    {
+      *--begin = '-';
+    }
+  }
+  this->WritePadded(begin, end - begin);
+}
+
+namespace
+{
+size_t NormalizeDecimalPoint(char *data, size_t length)
+{
+#if __linux__
+  // snprintf uses the decimal point of the C locale, which is also changed by std::locale::global with a named locale
+  const char *decimal_point = nl_langinfo(RADIXCHAR);
+  if (!decimal_point[0] || (decimal_point[0] == '.' && !decimal_point[1]))
+  {
+    return length;
+  }
+  const size_t decimal_point_length = std::strlen(decimal_point);
+  char *position = static_cast<char *>(memmem(data, length, decimal_point, decimal_point_length));
+  if (position)
+  {
+    *position = '.';
+    std::memmove(position + 1, position + decimal_point_length, data + length - position - decimal_point_length);
+    length -= decimal_point_length - 1;
+  }
+#endif
+  return length;
+}
+
+template <typename T>
+size_t FormatFloatingPoint(std::vector<char> &buffer, const std::ios_base &format, T value, const char *length_modifier)
+{
+  // Mirrors the conversion std::num_put uses internally
+  const std::ios_base::fmtflags flags = format.flags();
+  const std::ios_base::fmtflags floatfield = flags & std::ios_base::floatfield;
+  char conversion[8];
+  char *c = conversion;
+  *c++ = '%';
+  if (flags & std::ios_base::showpos)
+  {
+    *c++ = '+';
+  }
+  if (flags & std::ios_base::showpoint)
+  {
+    *c++ = '#';
+  }
+  *c++ = '.';
+  *c++ = '*';
+  while (*length_modifier)
+  {
+    *c++ = *length_modifier++;
+  }
+  const bool uppercase = flags & std::ios_base::uppercase;
+  *c++ = floatfield == std::ios_base::fixed ? 'f' : (floatfield == std::ios_base::scientific ? (uppercase ? 'E' : 'e') : (uppercase ? 'G' : 'g'));
+  *c = 0;
+
+  const int precision = format.precision() < 0 ? 6 : static_cast<int>(format.precision());
+  int length = snprintf(buffer.data(), buffer.size(), conversion, precision, value);
+  if (length >= 0 && static_cast<size_t>(length) >= buffer.size())
+  {
+    buffer.resize(length + 1);
+    length = snprintf(buffer.data(), buffer.size(), conversion, precision, value);
+  }
+  return length < 0 ? 0 : NormalizeDecimalPoint(buffer.data(), length);
+}
+}
+
+//----------------------------------------------------------------------
+// tStream WriteFloatingPoint
+//----------------------------------------------------------------------
+void tStream::WriteFloatingPoint(double value)
+{
+  std::vector<char> &floating_point_buffer = record_streams->floating_point_buffer;
+  this->WritePadded(floating_point_buffer.data(), FormatFloatingPoint(floating_point_buffer, this->stream, value, ""));
+}
+
+void tStream::WriteFloatingPoint(long double value)
+{
+  std::vector<char> &floating_point_buffer = record_streams->floating_point_buffer;
+  this->WritePadded(floating_point_buffer.data(), FormatFloatingPoint(floating_point_buffer, this->stream, value, "L"));
+}
+
+//----------------------------------------------------------------------
+// tStream WritePointer
+//----------------------------------------------------------------------
+void tStream::WritePointer(const void *pointer)
+{
+  char digits[2 + 2 * sizeof(uintptr_t)];
+  char *const end = digits + sizeof(digits);
+  char *begin = end;
+  uintptr_t bits = reinterpret_cast<uintptr_t>(pointer);
+  do
+  {
+    *--begin = cLOWERCASE_HEX_DIGITS[bits & 15];
+    bits >>= 4;
+  }
+  while (bits);
+  *--begin = 'x';
+  *--begin = '0';
+  this->WritePadded(begin, end - begin);
+}
+
+namespace
+{
+
+const unsigned long long cFRACTION_DIVISORS[] = { 1000000000, 100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1 };
+
+//! The text time::ToIsoString produced for the last second formatted by this thread
+/*! Within the same second, only the digits of the fraction change. The
+ *  text is only cached if its fraction matches the timestamp it was
+ *  created for, so that the output is always the one of ToIsoString.
+ */
+struct tTimestampCache
+{
+  bool valid;
+  long long second;
+  size_t length;
+  size_t fraction_offset;
+  size_t fraction_digits;
+  char text[cMAX_TIMESTAMP_LENGTH];
+
+  tTimestampCache() : valid(false), second(0), length(0), fraction_offset(0), fraction_digits(0) {}
+};
+
+// Without destructor, the cache stays usable for messages from destructors of other thread_local or static objects
+static_assert(std::is_trivially_destructible<tTimestampCache>::value, "The timestamp cache must survive the destruction of thread_local objects");
+thread_local tTimestampCache timestamp_cache;
+
+void SplitTimestamp(const rrlib::time::tTimestamp &value, long long &second, long long &nanoseconds)
+{
+  const long long nanoseconds_since_epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(value.time_since_epoch()).count();
+  second = nanoseconds_since_epoch / cNANOSECONDS_PER_SECOND;
+  nanoseconds = nanoseconds_since_epoch % cNANOSECONDS_PER_SECOND;
+  if (nanoseconds < 0)
+  {
+    nanoseconds += cNANOSECONDS_PER_SECOND;
+    second--;
+  }
+}
+
+bool UpdateTimestampCache(tTimestampCache &cache, const rrlib::time::tTimestamp &value, long long second, long long nanoseconds, const std::string &text)
+{
+  cache.valid = false;
+  const size_t time_of_day = text.find('T');
+  if (text.length() > sizeof(cache.text) || time_of_day == std::string::npos)
+  {
+    return false;
+  }
+
+  // The fraction follows the seconds of the time of day, e.g. 10:05:38.484397818
+  size_t fraction_offset = text.find_first_of(".,", time_of_day);
+  size_t fraction_digits = 0;
+  if (fraction_offset != std::string::npos)
+  {
+    fraction_offset++;
+    while (fraction_offset + fraction_digits < text.length() && text[fraction_offset + fraction_digits] >= '0' && text[fraction_offset + fraction_digits] <= '9')
+    {
+      fraction_digits++;
+    }
+    if (fraction_digits == 0 || fraction_digits > 9)
+    {
+      return false;
+    }
+    char fraction[9];
+    FormatDigits(fraction, nanoseconds / cFRACTION_DIVISORS[fraction_digits], fraction_digits);
+    if (std::memcmp(fraction, text.data() + fraction_offset, fraction_digits) != 0)
+    {
+      return false;
+    }
+  }
+
+  // Only the fraction may change within the same second. Check that with the last timestamp of this second, which also reveals rounding
+  const rrlib::time::tTimestamp last = value + std::chrono::duration_cast<rrlib::time::tTimestamp::duration>(std::chrono::nanoseconds(cNANOSECONDS_PER_SECOND - 1 - nanoseconds));
+  long long last_second = 0;
+  long long last_nanoseconds = 0;
+  SplitTimestamp(last, last_second, last_nanoseconds);
+  std::memcpy(cache.text, text.data(), text.length());
+  if (fraction_digits)
+  {
+    FormatDigits(cache.text + fraction_offset, last_nanoseconds / cFRACTION_DIVISORS[fraction_digits], fraction_digits);
+  }
+  const std::string last_text = time::ToIsoString(last);
+  if (last_second != second || last_text.length() != text.length() || std::memcmp(last_text.data(), cache.text, text.length()) != 0)
+  {
+    return false;
+  }
+
+  cache.length = text.length();
+  cache.fraction_offset = fraction_offset;
+  cache.fraction_digits = fraction_digits;
+  cache.second = second;
+  cache.valid = true;
+  return true;
+}
+
+}
+
+//----------------------------------------------------------------------
+// tStream WriteTimestamp
+//----------------------------------------------------------------------
+void tStream::WriteTimestamp(const rrlib::time::tTimestamp &value)
+{
+  long long second = 0;
+  long long nanoseconds = 0;
+  SplitTimestamp(value, second, nanoseconds);
+
+  tTimestampCache &cache = timestamp_cache;
+  if (!cache.valid || second != cache.second)
+  {
+    const std::string text = time::ToIsoString(value);
+    if (!UpdateTimestampCache(cache, value, second, nanoseconds, text))
+    {
+      this->WritePadded(text.data(), text.length());
+      return;
+    }
+  }
+  if (cache.fraction_digits)
+  {
+    FormatDigits(cache.text + cache.fraction_offset, nanoseconds / cFRACTION_DIVISORS[cache.fraction_digits], cache.fraction_digits);
+  }
+  this->WritePadded(cache.text, cache.length);
+}
+
+//----------------------------------------------------------------------
+// tStream WritePadded
+//----------------------------------------------------------------------
+void tStream::WritePadded(const char *data, size_t length)
+{
+  const std::streamsize width = this->stream.width();
+  this->stream.width(0);
+  if (width <= static_cast<std::streamsize>(length))
+  {
+    this->record_buffer.sputn(data, length);
+    return;
+  }
+
+  const bool left = (this->stream.flags() & std::ios_base::adjustfield) == std::ios_base::left;
+  if (left)
+  {
+    this->record_buffer.sputn(data, length);
+  }
+  const char fill = this->stream.fill();
+  for (std::streamsize i = length; i < width; ++i)
   {
-    this->stream << std::flush;
+    this->record_buffer.sputc(fill);
   }
-  else
+  if (!left)
   {
-    this->stream << std::endl;
+    this->record_buffer.sputn(data, length);
   }
 }
 
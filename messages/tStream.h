@@ -37,12 +37,12 @@
  * By returning a proxy for each output stream the logging domain creates
  * a temporary object that lives as long as consecutive streaming
  * operations are performed. Afterwards, the proxy will be destroyed
- * immediately. Hence, the correct times for acquiring and releasing the
- * lock are defined.
+ * immediately. Hence, the correct time for writing the complete message
+ * is defined.
  *
- * Assigning the proxy object to a local variable allows locking over
- * multiple lines of code if this is really necessary. However, creation
- * on the heap is not supported to avoid dangling locks.
+ * The message is collected in a thread local record buffer without
+ * holding any lock. Only writing the finished record to the sinks is
+ * synchronized.
  *
  */
 //----------------------------------------------------------------------
@@ -58,14 +58,18 @@
 //----------------------------------------------------------------------
 #include <iostream>
 #include <mutex>
+#include <type_traits>
 
 #include <exception>
+#include "rrlib/design_patterns/singleton.h"
 #include "rrlib/time/time.h"
 #include "rrlib/util/demangle.h"
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "rrlib/logging/messages/tRecordBuffer.h"
+#include "rrlib/logging/messages/tTypeNameCache.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -82,6 +86,10 @@ namespace logging
 //----------------------------------------------------------------------
 // Forward declarations / typedefs / enums
 //----------------------------------------------------------------------
+class tFanOutBuffer;
+
+//! The lock that is held by tStream while a message is written to the sinks
+typedef design_patterns::tSingletonHolder<std::mutex, design_patterns::singleton::PhoenixSingleton> tStreamMutex;
 
 //----------------------------------------------------------------------
 // Class declaration
@@ -94,12 +102,12 @@ namespace logging
  *  By returning a proxy for each output stream the logging domain creates
  *  a temporary object that lives as long as consecutive streaming
  *  operations are performed. Afterwards, the proxy will be destroyed
- *  immediately. Hence, the correct times for acquiring and releasing the
- *  lock are defined.
+ *  immediately. Hence, the correct time for writing the message to the
+ *  sinks is defined.
  *
- *  Assigning the proxy object to a local variable allows locking over
- *  multiple lines of code if this is really necessary. However, creation
- *  on the heap is not supported to avoid dangling locks.
+ *  Assigning the proxy object to a local variable allows collecting a
+ *  message over multiple lines of code if this is really necessary.
+ *  However, creation on the heap is not supported.
  *
  */
 class tStream
@@ -112,19 +120,31 @@ public:
 
   /*! The ctor of tStream
    *
-   * Acquires a lock for the output.
-   * This methods blocks until the lock can be acquired.
+   * Starts a new record in a thread local buffer. The std::ostream used
+   * for streaming is kept along with that buffer and only gets its
+   * format state reset. Nested streams (e.g. from messages sent while
+   * streaming another message) use their own buffers and streams.
    *
-   * \param stream   The std::ostream that is used via this proxy
+   * \param target   The buffer that fans out the finished record to the sinks
    */
-  explicit tStream(std::streambuf *stream_buffer);
+  explicit tStream(tFanOutBuffer &target);
 
-  /*! The ctor of tStream
+  /*! The dtor of tStream
    *
-   * Releases the lock for the output and takes care of flushing and trailing newlines.
+   * Takes care of trailing newlines and writes the record to the sinks
+   * while holding the output lock.
    */
   ~tStream();
 
+  /*! Get the buffer the record is collected in
+   *
+   * \returns The record buffer of this stream
+   */
+  inline tRecordBuffer &Buffer()
+  {
+    return this->record_buffer;
+  }
+
   /*! Streaming operator (forwarder)
    *
    * This method forwards the streaming operation to the wrapped
@@ -137,13 +157,14 @@ public:
   template <typename T>
   inline typename std::enable_if < !std::is_base_of<std::exception, T>::value, tStream >::type &operator << (const T &value)
   {
-    this->stream << value;
+    this->Insert(value, std::integral_constant<tNumberCategory, tNumberTraits<T>::cCATEGORY>());
     return *this;
   }
 
   /*! Streaming operator for exceptions
    *
-   * This method implements log streaming for std::exception
+   * This method implements log streaming for std::exception. The type
+   * name is demangled only once per type (see tTypeNameCache).
    *
    * \param exception   The exception to put into the stream
    *
@@ -151,7 +172,7 @@ public:
    */
   inline tStream &operator << (const std::exception &exception)
   {
-    this->stream << "Exception (" << util::Demangle(typeid(exception).name()) << "): " << exception.what();
+    this->stream << "Exception (" << tTypeNameCache::Instance().GetDemangledName(typeid(exception)) << "): " << exception.what();
     return *this;
   }
 
@@ -194,6 +215,8 @@ public:
    *
    * There are no iostream operators for the std::chrono::time_point
    * template. Therefore, we need an operator implementation here.
+   * The timestamp is written like time::ToIsoString does. Its text is
+   * reused within the same second with only the fraction replaced.
    *
    * \param value   The duration value to put into the stream.
    *
@@ -201,7 +224,7 @@ public:
    */
   inline tStream &operator << (const rrlib::time::tTimestamp &value)
   {
-    this->stream << time::ToIsoString(value);
+    this->WriteTimestamp(value);
     return *this;
   }
 
@@ -239,7 +262,7 @@ public:
       this->stream << "<nullptr>";
       return *this;
     }
-    this->stream << pointer;
+    this->InsertPointer(pointer, std::integral_constant<bool, tNumberTraits<T>::cPRINTS_ADDRESS>());
     return *this;
   }
 
@@ -271,8 +294,112 @@ public:
 //----------------------------------------------------------------------
 private:
 
-  std::ostream stream;
-  std::unique_lock<std::mutex> lock;
+  enum tNumberCategory
+  {
+    eNC_OTHER,
+    eNC_INTEGER,
+    eNC_FLOATING_POINT
+  };
+
+  //! Selects the types that are formatted without std::num_put (characters are printed as such, not as numbers)
+  template <typename T>
+  struct tNumberTraits
+  {
+    typedef typename std::remove_cv<T>::type tValue;
+    static const bool cIS_CHARACTER = std::is_same<tValue, bool>::value || std::is_same<tValue, char>::value || std::is_same<tValue, signed char>::value || std::is_same<tValue, unsigned char>::value
+                                      || std::is_same<tValue, wchar_t>::value || std::is_same<tValue, char16_t>::value || std::is_same<tValue, char32_t>::value;
+    static const tNumberCategory cCATEGORY = std::is_floating_point<T>::value ? eNC_FLOATING_POINT : (std::is_integral<T>::value && !cIS_CHARACTER) ? eNC_INTEGER : eNC_OTHER;
+    static const bool cPRINTS_ADDRESS = !cIS_CHARACTER && !std::is_volatile<T>::value && !std::is_function<T>::value;
+  };
+
+  tFanOutBuffer &target;
+  tRecordBuffer &record_buffer;
+  std::ostream &stream;
+  const bool classic_locale;
+
+  /*! Find out whether numbers can be formatted without std::num_put
+   *
+   * This is the case if the stream uses the classic locale and no
+   * unsupported formatting flag is set.
+   *
+   * \param unsupported_flags   The flags the fast formatting does not support
+   *
+   * \returns Whether fast formatting can be used
+   */
+  inline bool UsesFastNumberFormatting(std::ios_base::fmtflags unsupported_flags) const
+  {
+    return this->classic_locale && !(this->stream.flags() & unsupported_flags);
+  }
+
+  template <typename T>
+  inline void Insert(const T &value, std::integral_constant<tNumberCategory, eNC_OTHER>)
+  {
+    this->stream << value;
+  }
+
+  template <typename T>
+  inline void Insert(const T &value, std::integral_constant<tNumberCategory, eNC_INTEGER>)
+  {
+    if (!this->UsesFastNumberFormatting(std::ios_base::showpos | std::ios_base::showbase | std::ios_base::internal))
+    {
+      this->stream << value;
+      return;
+    }
+    typedef typename std::make_unsigned<T>::type tUnsigned;
+    const bool negative = std::is_signed<T>::value && value < static_cast<T>(0);
+    const tUnsigned bits = static_cast<tUnsigned>(value);
+    this->WriteInteger(bits, negative ? static_cast<tUnsigned>(0u - bits) : bits, negative);
+  }
+
+  template <typename T>
+  inline void Insert(const T &value, std::integral_constant<tNumberCategory, eNC_FLOATING_POINT>)
+  {
+    if (!this->UsesFastNumberFormatting(std::ios_base::internal) || (this->stream.flags() & std::ios_base::floatfield) == std::ios_base::floatfield)
+    {
+      this->stream << value;
+      return;
+    }
+    this->WriteFloatingPoint(value);
+  }
+
+  template <typename T>
+  inline void InsertPointer(const T *pointer, std::false_type)
+  {
+    this->stream << pointer;
+  }
+
+  template <typename T>
+  inline void InsertPointer(const T *pointer, std::true_type)
+  {
+    if (!this->UsesFastNumberFormatting(std::ios_base::internal))
+    {
+      this->stream << pointer;
+      return;
+    }
+    this->WritePointer(pointer);
+  }
+
+  /*! Write an integer like std::num_put does for the classic locale
+   *
+   * \param bits        The value as unsigned number (used for hex and oct)
+   * \param magnitude   The absolute value (used for dec)
+   * \param negative    Whether the value is negative
+   */
+  void WriteInteger(unsigned long long bits, unsigned long long magnitude, bool negative);
+
+  void WriteFloatingPoint(double value);
+  void WriteFloatingPoint(long double value);
+
+  void WritePointer(const void *pointer);
+
+  void WriteTimestamp(const rrlib::time::tTimestamp &value);
+
+  /*! Write a formatted value obeying the stream's width, fill and adjustment
+   *
+   * \param data     The formatted value
+   * \param length   The length of the formatted value
+   */
+  void WritePadded(const char *data, size_t length);
 
   // Prohibit copy
   tStream(const tStream &other);
@@ -0,0 +1,183 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/logging/messages/tTypeNameCache.cpp
+ *
+ * \author  Tobias Föhst
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#define __rrlib__logging__include_guard__
+#include "rrlib/logging/messages/tTypeNameCache.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cassert>
+
+#include "rrlib/util/demangle.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace logging
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+const size_t cINITIAL_TYPE_NAME_INDEX_SIZE = 16;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// tTypeNameCacheImplementation constructors
+//----------------------------------------------------------------------
+tTypeNameCacheImplementation::tTypeNameCacheImplementation()
+  : index(NULL)
+{}
+
+tTypeNameCacheImplementation::tIndex::tIndex(size_t size)
+  : mask(size - 1),
+    slots(new std::atomic<const tEntry *>[size])
+{
+  assert((size & this->mask) == 0 && "size must be a power of two");
+  for (size_t i = 0; i < size; ++i)
+  {
+    this->slots[i].store(NULL, std::memory_order_relaxed);
+  }
+}
+
+//----------------------------------------------------------------------
+// tTypeNameCacheImplementation GetDemangledName
+//----------------------------------------------------------------------
+const std::string &tTypeNameCacheImplementation::GetDemangledName(const std::type_info &type)
+{
+  const size_t hash = type.hash_code();
+  const tEntry *entry = this->Find(type, hash);
+  if (!entry)
+  {
+    entry = this->Insert(type, hash);
+  }
+  return entry->name;
+}
+
+//----------------------------------------------------------------------
+// tTypeNameCacheImplementation Find
+//----------------------------------------------------------------------
+const tTypeNameCacheImplementation::tEntry *tTypeNameCacheImplementation::Find(const std::type_info &type, size_t hash) const
+{
+  const tIndex *index = this->index.load(std::memory_order_acquire);
+  if (!index)
+  {
+    return NULL;
+  }
+
+  // Linear probing in open addressed hash index (size is a power of two)
+  for (size_t i = hash & index->mask;; i = (i + 1) & index->mask)
+  {
+    const tEntry *candidate = index->slots[i].load(std::memory_order_acquire);
+    if (!candidate)
+    {
+      return NULL;
+    }
+    if (candidate->hash == hash && *candidate->type == type)
+    {
+      return candidate;
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+// tTypeNameCacheImplementation Insert
+//----------------------------------------------------------------------
+const tTypeNameCacheImplementation::tEntry *tTypeNameCacheImplementation::Insert(const std::type_info &type, size_t hash)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  const tEntry *entry = this->Find(type, hash);
+  if (entry)
+  {
+    return entry;
+  }
+
+  // Demangle before publishing, so that readers only see complete entries
+  tEntry *new_entry = new tEntry();
+  new_entry->type = &type;
+  new_entry->hash = hash;
+  new_entry->name = util::Demangle(type.name());
+  this->entries.emplace_back(new_entry);
+
+  // Publish a new index with double size if load factor would exceed 1/2
+  // Replaced indices are kept until destruction as concurrent readers might still use them
+  tIndex *index = this->index.load(std::memory_order_relaxed);
+  if (!index || 2 * this->entries.size() > index->mask + 1)
+  {
+    index = new tIndex(index ? 2 * (index->mask + 1) : cINITIAL_TYPE_NAME_INDEX_SIZE);
+    this->indices.emplace_back(index);
+    for (auto it = this->entries.begin(); it != this->entries.end(); ++it)
+    {
+      size_t i = (*it)->hash & index->mask;
+      while (index->slots[i].load(std::memory_order_relaxed))
+      {
+        i = (i + 1) & index->mask;
+      }
+      index->slots[i].store(it->get(), std::memory_order_relaxed);
+    }
+    this->index.store(index, std::memory_order_release);
+    return new_entry;
+  }
+
+  size_t i = hash & index->mask;
+  while (index->slots[i].load(std::memory_order_relaxed))
+  {
+    i = (i + 1) & index->mask;
+  }
+  index->slots[i].store(new_entry, std::memory_order_release);
+  return new_entry;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
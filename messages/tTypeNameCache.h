@@ -0,0 +1,145 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/logging/messages/tTypeNameCache.h
+ *
+ * \author  Tobias Föhst
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tTypeNameCache
+ *
+ * \b tTypeNameCache
+ *
+ * Demangling a type name allocates memory and is slow compared to the
+ * rest of a log message. Exceptions of the same few types are often
+ * logged over and over again, e.g. from a failing driver. Thus, the
+ * demangled names are stored in a cache that is read without locks.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__logging__include_guard__
+#error Invalid include directive. Try #include "rrlib/logging/messages.h" instead.
+#endif
+
+#ifndef __rrlib__logging__messages__tTypeNameCache_h__
+#define __rrlib__logging__messages__tTypeNameCache_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include "rrlib/design_patterns/singleton.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace logging
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+class tTypeNameCacheImplementation;
+typedef design_patterns::tSingletonHolder<tTypeNameCacheImplementation, design_patterns::singleton::PhoenixSingleton> tTypeNameCache;
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! A cache of demangled type names
+/*! Each type is demangled once. Lookups are lock-free: the cache is an
+ *  open addressed hash index of entries that is only published when
+ *  completely filled. Entries and replaced indices are kept until the
+ *  cache is destroyed, so the returned names stay valid.
+ *
+ */
+class tTypeNameCacheImplementation
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tTypeNameCacheImplementation();
+
+  /*! Get the demangled name of a type
+   *
+   * \param type   The type info of the type (e.g. from typeid)
+   *
+   * \returns The demangled name, which stays valid as long as the cache
+   */
+  const std::string &GetDemangledName(const std::type_info &type);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  struct tEntry
+  {
+    const std::type_info *type;
+    size_t hash;
+    std::string name;
+  };
+
+  struct tIndex
+  {
+    const size_t mask;
+    std::unique_ptr<std::atomic<const tEntry *>[]> slots;
+
+    explicit tIndex(size_t size);
+  };
+
+  std::atomic<tIndex *> index;
+  std::vector<std::unique_ptr<tIndex>> indices;
+  std::vector<std::unique_ptr<const tEntry>> entries;
+  std::mutex mutex;
+
+  const tEntry *Find(const std::type_info &type, size_t hash) const;
+
+  const tEntry *Insert(const std::type_info &type, size_t hash);
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
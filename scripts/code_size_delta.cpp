@@ -0,0 +1,91 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/logging/scripts/code_size_delta.cpp
+ *
+ * \author  Tobias Föhst
+ *
+ * \date    2026-10-16
+ *
+ * Build target for code_size_delta.sh, which reports the code size
+ * delta of each translation unit between two builds. The script is
+ * expected next to this source file unless RRLIB_LOGGING_SCRIPTS
+ * points to another directory.
+ *
+ * Usage: code_size_delta <baseline object dir> <object dir>
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <libgen.h>
+#include <unistd.h>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+int main(int argc, char **argv)
+{
+  const char *scripts_directory = std::getenv("RRLIB_LOGGING_SCRIPTS");
+  std::string source_file(__FILE__);
+  std::string script = std::string(scripts_directory ? scripts_directory : dirname(&source_file[0])) + "/code_size_delta.sh";
+
+  std::vector<char *> arguments;
+  arguments.push_back(const_cast<char *>("sh"));
+  arguments.push_back(&script[0]);
+  for (int i = 1; i < argc; ++i)
+  {
+    arguments.push_back(argv[i]);
+  }
+  arguments.push_back(NULL);
+
+  execv("/bin/sh", arguments.data());
+  std::cerr << "Could not run " << script << std::endl;
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,79 @@
+#!/bin/sh
+#
+# You received this file as part of RRLib
+# Robotics Research Library
+#
+# Copyright (C) Finroc GbR (finroc.org)
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along
+# with this program; if not, write to the Free Software Foundation, Inc.,
+# 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+#
+#----------------------------------------------------------------------
+# Reports the code size delta of each translation unit between two builds
+#
+# Usage: code_size_delta.sh <baseline object dir> <object dir>
+#
+# The program target code_size_delta (see make.xml) runs this script.
+#
+# Both directories are searched for object files (*.o). Files with the
+# same path relative to their directory are compared by the size of
+# their text section as reported by size(1). Translation units that
+# exist in only one of the builds count as 0 in the other one.
+#
+# Example (object files of a program using rrlib_logging before and
+# after a change):
+#   code_size_delta.sh build.before/obj build/obj
+#----------------------------------------------------------------------
+
+set -e
+
+if [ $# -ne 2 ] || [ ! -d "$1" ] || [ ! -d "$2" ]
+then
+  echo "Usage: $0 <baseline object dir> <object dir>" >&2
+  exit 1
+fi
+
+SIZE=${SIZE:-size}
+
+text_sizes()
+{
+  (cd "$1" && find . -name '*.o' | sort | while read -r object
+   do
+     printf '%s %s\n' "${object#./}" "$("$SIZE" "$object" | awk 'NR == 2 { print $1 }')"
+   done)
+}
+
+BASELINE=$(mktemp)
+CURRENT=$(mktemp)
+trap 'rm -f "$BASELINE" "$CURRENT"' EXIT
+
+text_sizes "$1" > "$BASELINE"
+text_sizes "$2" > "$CURRENT"
+
+awk '
+  NR == FNR { baseline[$1] = $2; units[$1] = 1; next }
+  { current[$1] = $2; units[$1] = 1 }
+  END {
+    printf "%10s %10s %10s  %s\n", "before", "after", "delta", "translation unit"
+    for (unit in units)
+    {
+      delta = current[unit] - baseline[unit]
+      printf "%10d %10d %+10d  %s\n", baseline[unit], current[unit], delta, unit | "sort -k4"
+      total_baseline += baseline[unit]
+      total_current += current[unit]
+    }
+    close("sort -k4")
+    printf "%10d %10d %+10d  %s\n", total_baseline, total_current, total_current - total_baseline, "total"
+  }
+' "$BASELINE" "$CURRENT"
@@ -0,0 +1,85 @@
+#!/bin/sh
+#
+# You received this file as part of RRLib
+# Robotics Research Library
+#
+# Copyright (C) Finroc GbR (finroc.org)
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along
+# with this program; if not, write to the Free Software Foundation, Inc.,
+# 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+#
+#----------------------------------------------------------------------
+# Generates a domain manifest for LoadDomainManifest from source files
+#
+# Usage: generate_domain_manifest.sh <source root> [<source file> ...]
+#
+# The source root must be one of the entries of RRLIB_LOGGING_PATH the
+# program will run with. Without explicit source files, all C and C++
+# sources and headers below the source root are scanned. Each file that
+# uses the logging macros gets a line with its path relative to the
+# source root, followed by the domains of its RRLIB_LOG_*_TO calls.
+# The manifest is written to stdout.
+#
+# Example (as a build step):
+#   generate_domain_manifest.sh sources/cpp > etc/logging_domains.manifest
+#----------------------------------------------------------------------
+
+set -e
+
+if [ $# -lt 1 ] || [ ! -d "$1" ]
+then
+  echo "Usage: $0 <source root> [<source file> ...]" >&2
+  exit 1
+fi
+
+SOURCE_ROOT=${1%/}
+shift
+
+source_files()
+{
+  if [ $# -eq 0 ]
+  then
+    find "$SOURCE_ROOT" -type f \( -name '*.cpp' -o -name '*.cc' -o -name '*.c' -o -name '*.h' -o -name '*.hpp' \) | sort
+    return
+  fi
+  for file in "$@"
+  do
+    case "$file" in
+      /*|"$SOURCE_ROOT"/*) echo "$file" ;;
+      *) echo "$SOURCE_ROOT/$file" ;;
+    esac
+  done
+}
+
+echo "# Generated by $(basename "$0") from $SOURCE_ROOT"
+source_files "$@" | while read -r file
+do
+  case "$file" in
+    "$SOURCE_ROOT"/*) ;;
+    *)
+      echo "$0: '$file' is not located in '$SOURCE_ROOT'" >&2
+      exit 1
+      ;;
+  esac
+
+  # Skip macro definitions (also their continuation lines) and comments, then join lines as macro calls might span several of them
+  calls=$(sed -e '/^[[:space:]]*#/d' -e '/\\[[:space:]]*$/d' -e '/^[[:space:]]*\/\//d' -e '/^[[:space:]]*\*/d' "$file" | tr '\n' ' ' | grep -o 'RRLIB_LOG_[A-Z_]*[[:space:]]*([^,)]*' || true)
+  if [ -z "$calls" ]
+  then
+    continue
+  fi
+
+  domains=$(echo "$calls" | sed -n 's/^RRLIB_LOG_[A-Z_]*_TO[[:space:]]*([[:space:]]*\([^[:space:]]*\)[[:space:]]*$/\1/p' | sort -u | tr '\n' ' ')
+  echo "${file#"$SOURCE_ROOT"/} $domains" | sed 's/[[:space:]]*$//'
+done
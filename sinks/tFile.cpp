@@ -113,7 +113,7 @@ std::streambuf &tFile::GetStreamBuffer()
       throw std::runtime_error(message.str());
     }
 
-    std::string fqdn = this->configuration.GetFullQualifiedName();
+    const std::string &fqdn = this->configuration.GetFullQualifiedName();
     std::string file_name(file_name_prefix + (fqdn != "." ? fqdn : "") + ".log");
     this->file_stream.open(file_name.c_str(), std::ios::out | std::ios::trunc);
     if (!this->file_stream.is_open())
@@ -0,0 +1,180 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/logging/tests/domain_manifest.cpp
+ *
+ * \author  Tobias Föhst
+ *
+ * \date    2026-10-16
+ *
+ * Round trip of scripts/generate_domain_manifest.sh: a manifest is
+ * generated from a small source tree, loaded via LoadDomainManifest
+ * and frozen. Afterwards, exactly the expected domains must exist and
+ * looking them up must not create any new ones.
+ *
+ * Usage: domain_manifest [<path to generate_domain_manifest.sh>]
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+
+#include <libgen.h>
+#include <sys/stat.h>
+
+#include "rrlib/logging/configuration.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+using namespace rrlib::logging;
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+namespace
+{
+
+void WriteFile(const std::string &filename, const std::string &content)
+{
+  std::ofstream file(filename.c_str());
+  file << content;
+}
+
+void CollectDomainNames(const tConfiguration &configuration, std::set<std::string> &names)
+{
+  names.insert(configuration.GetFullQualifiedName());
+  const std::vector<tConfiguration *> children = configuration.Children();
+  for (auto it = children.begin(); it != children.end(); ++it)
+  {
+    CollectDomainNames(**it, names);
+  }
+}
+
+std::set<std::string> DomainNames()
+{
+  std::set<std::string> names;
+  CollectDomainNames(tDomainRegistry::Instance().GetConfigurationBySourceRelativeFilename(cDEFAULT_CONTEXT, NULL, "."), names);
+  return names;
+}
+
+bool Check(bool condition, const char *description)
+{
+  if (!condition)
+  {
+    std::cerr << "FAILED: " << description << std::endl;
+  }
+  return condition;
+}
+
+}
+
+int main(int argc, char **argv)
+{
+  std::string script;
+  if (argc > 1)
+  {
+    script = argv[1];
+  }
+  else
+  {
+    std::string test_source(__FILE__);
+    script = std::string(dirname(&test_source[0])) + "/../scripts/generate_domain_manifest.sh";
+  }
+
+  char source_root_template[] = "/tmp/rrlib_logging_domain_manifest_XXXXXX";
+  const char *source_root = mkdtemp(source_root_template);
+  if (!source_root)
+  {
+    std::cerr << "Could not create temporary source tree" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string root(source_root);
+  mkdir((root + "/a").c_str(), 0755);
+  mkdir((root + "/a/b").c_str(), 0755);
+  mkdir((root + "/c").c_str(), 0755);
+  WriteFile(root + "/a/b/one.cpp",
+            "void f()\n"
+            "{\n"
+            "  RRLIB_LOG_PRINT(DEBUG, \"message\");\n"
+            "  RRLIB_LOG_PRINT_TO(sub, ERROR, \"message\");\n"
+            "  RRLIB_LOG_FMT_TO(\n"
+            "    sub, WARNING, \"{}\", 1);\n"
+            "}\n");
+  WriteFile(root + "/a/two.h",
+            "#define RRLIB_LOG_PRINT_TO(domain, level, args...) \\\n"
+            "  something(domain)\n"
+            "inline void g() { RRLIB_LOG_PRINTF_TO(.abs.domain, DEBUG, \"%d\", 1); }\n");
+  WriteFile(root + "/c/none.cpp", "// RRLIB_LOG_PRINT_TO(commented, DEBUG, \"x\");\nvoid h() {}\n");
+
+  const std::string manifest = root + "/domains.manifest";
+  const int result = std::system(("sh '" + script + "' '" + root + "' > '" + manifest + "'").c_str());
+
+  bool ok = Check(result == 0, "generator runs successfully");
+  ok = ok && Check(LoadDomainManifest(manifest), "manifest can be loaded");
+  if (ok)
+  {
+    FreezeDomainRegistry();
+
+    const std::set<std::string> expected { ".", ".a", ".a.b", ".a.b.sub", ".abs", ".abs.domain" };
+    ok = Check(DomainNames() == expected, "exactly the domains of the sources were created");
+
+    tDomainRegistryImplementation &registry = tDomainRegistry::Instance();
+    const tConfiguration &one = registry.GetConfigurationBySourceRelativeFilename(cDEFAULT_CONTEXT, "a/b/one.cpp");
+    const tConfiguration &sub = registry.GetConfigurationBySourceRelativeFilename(cDEFAULT_CONTEXT, "a/b/one.cpp", "sub");
+    const tConfiguration &absolute = registry.GetConfigurationBySourceRelativeFilename(cDEFAULT_CONTEXT, "a/two.h", ".abs.domain");
+    ok = Check(one.GetFullQualifiedName() == ".a.b" && sub.GetFullQualifiedName() == ".a.b.sub" && absolute.GetFullQualifiedName() == ".abs.domain", "frozen lookups find the loaded domains") && ok;
+    ok = Check(DomainNames() == expected, "lookups after loading do not create domains") && ok;
+  }
+
+  std::system(("rm -rf '" + root + "'").c_str());
+
+  if (!ok)
+  {
+    return EXIT_FAILURE;
+  }
+  std::cout << "domain manifest round trip passed" << std::endl;
+  return EXIT_SUCCESS;
+}